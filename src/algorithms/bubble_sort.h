@@ -54,14 +54,17 @@ public:
  canvasIds.push_back(node.id); // e.g. arr_0, arr_1, ...
  }
 
+ // Running label table: frames share it and only swapped slots change
+ LabelTable labels = LabelTable::fromValues(canvasIds, data);
+
  if (n <=1) {
  // Already sorted - record a single completion frame
  AnimationFrame frame;
  frame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  frame.addHighlightedNode(canvasIds[i], "green");
- frame.nodeLabels[canvasIds[i]] = std::to_string(data[i]);
  }
+ frame.nodeLabels = labels;
  frame.addAnnotation("Array is already sorted");
  recorder.recordFrame(frame);
  return recorder.getAllFrames();
@@ -72,8 +75,8 @@ public:
  initialFrame.operationType = "Initial State";
  for (int i =0; i < n; i++) {
  initialFrame.addHighlightedNode(canvasIds[i], "blue");
- initialFrame.nodeLabels[canvasIds[i]] = std::to_string(data[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Bubble Sort");
  recorder.recordFrame(initialFrame);
 
@@ -90,9 +93,9 @@ public:
  } else {
  passFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- passFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
  }
- passFrame.addAnnotation("Pass " + std::to_string(i +1) + ": Scanning unsorted portion");
+ passFrame.nodeLabels = labels;
+ passFrame.addAnnotation({ FrameAnnotation::Id::PassStart, i +1 });
  recorder.recordFrame(passFrame);
 
  for (int j =0; j < n - i -1; ++j) {
@@ -107,15 +110,17 @@ public:
  } else {
  compareFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- compareFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
  }
- compareFrame.addAnnotation("Comparing: " + std::to_string(data[j]) + " and " + std::to_string(data[j +1]));
+ compareFrame.nodeLabels = labels;
+ compareFrame.addAnnotation({ FrameAnnotation::Id::Comparing, data[j], data[j +1] });
  recorder.recordFrame(compareFrame);
 
  if (data[j] > data[j +1]) {
  // Swap elements and record swap frame
  std::swap(data[j], data[j +1]);
  swapped = true;
+ labels.set(canvasIds[j], std::to_string(data[j]));
+ labels.set(canvasIds[j +1], std::to_string(data[j +1]));
 
  AnimationFrame swapFrame;
  swapFrame.operationType = "Swap";
@@ -127,9 +132,9 @@ public:
  } else {
  swapFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- swapFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
  }
- swapFrame.addAnnotation("Swapped: " + std::to_string(data[j]) + " and " + std::to_string(data[j +1]));
+ swapFrame.nodeLabels = labels;
+ swapFrame.addAnnotation({ FrameAnnotation::Id::Swapped, data[j], data[j +1] });
  recorder.recordFrame(swapFrame);
  }
  }
@@ -143,9 +148,9 @@ public:
  } else {
  sortedFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- sortedFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
  }
- sortedFrame.addAnnotation("Element " + std::to_string(data[n - i -1]) + " is now in final position");
+ sortedFrame.nodeLabels = labels;
+ sortedFrame.addAnnotation({ FrameAnnotation::Id::ElementSorted, data[n - i -1] });
  recorder.recordFrame(sortedFrame);
 
  // Early exit optimization: if no swaps, array is sorted
@@ -154,8 +159,8 @@ public:
  earlyExitFrame.operationType = "Early Exit";
  for (int k =0; k < n; k++) {
  earlyExitFrame.addHighlightedNode(canvasIds[k], "green");
- earlyExitFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
  }
+ earlyExitFrame.nodeLabels = labels;
  earlyExitFrame.addAnnotation("No swaps needed - array is sorted!");
  recorder.recordFrame(earlyExitFrame);
  break;
@@ -167,8 +172,8 @@ public:
  finalFrame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  finalFrame.addHighlightedNode(canvasIds[i], "green");
- finalFrame.nodeLabels[canvasIds[i]] = std::to_string(data[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Bubble Sort Complete!");
  recorder.recordFrame(finalFrame);
  }
@@ -184,14 +189,15 @@ public:
  }
 
  int n = static_cast<int>(values.size());
+ LabelTable labels = LabelTable::fromValues(canvasIds, values);
  if (n <=1) {
  // Already sorted - record a single completion frame
  AnimationFrame frame;
  frame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  frame.addHighlightedNode(canvasIds[i], "green");
- frame.nodeLabels[canvasIds[i]] = std::to_string(values[i]);
  }
+ frame.nodeLabels = labels;
  frame.addAnnotation("List is already sorted");
  recorder.recordFrame(frame);
  return recorder.getAllFrames();
@@ -202,8 +208,8 @@ public:
  initialFrame.operationType = "Initial State";
  for (int i =0; i < n; i++) {
  initialFrame.addHighlightedNode(canvasIds[i], "blue");
- initialFrame.nodeLabels[canvasIds[i]] = std::to_string(values[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Bubble Sort on List");
  recorder.recordFrame(initialFrame);
 
@@ -220,9 +226,9 @@ public:
  } else {
  passFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- passFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
  }
- passFrame.addAnnotation("Pass " + std::to_string(i +1) + ": Scanning unsorted portion");
+ passFrame.nodeLabels = labels;
+ passFrame.addAnnotation({ FrameAnnotation::Id::PassStart, i +1 });
  recorder.recordFrame(passFrame);
 
  for (int j =0; j < n - i -1; ++j) {
@@ -236,14 +242,16 @@ public:
  } else {
  compareFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- compareFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
  }
- compareFrame.addAnnotation("Comparing: " + std::to_string(values[j]) + " and " + std::to_string(values[j +1]));
+ compareFrame.nodeLabels = labels;
+ compareFrame.addAnnotation({ FrameAnnotation::Id::Comparing, values[j], values[j +1] });
  recorder.recordFrame(compareFrame);
 
  if (values[j] > values[j +1]) {
  std::swap(values[j], values[j +1]);
  swapped = true;
+ labels.set(canvasIds[j], std::to_string(values[j]));
+ labels.set(canvasIds[j +1], std::to_string(values[j +1]));
 
  AnimationFrame swapFrame;
  swapFrame.operationType = "Swap";
@@ -255,9 +263,9 @@ public:
  } else {
  swapFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- swapFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
  }
- swapFrame.addAnnotation("Swapped: " + std::to_string(values[j]) + " and " + std::to_string(values[j +1]));
+ swapFrame.nodeLabels = labels;
+ swapFrame.addAnnotation({ FrameAnnotation::Id::Swapped, values[j], values[j +1] });
  recorder.recordFrame(swapFrame);
  }
  }
@@ -270,9 +278,9 @@ public:
  } else {
  sortedFrame.addHighlightedNode(canvasIds[k], "lightgray");
  }
- sortedFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
  }
- sortedFrame.addAnnotation("Element " + std::to_string(values[n - i -1]) + " is now in final position");
+ sortedFrame.nodeLabels = labels;
+ sortedFrame.addAnnotation({ FrameAnnotation::Id::ElementSorted, values[n - i -1] });
  recorder.recordFrame(sortedFrame);
 
  if (!swapped) {
@@ -280,8 +288,8 @@ public:
  earlyExitFrame.operationType = "Early Exit";
  for (int k =0; k < n; k++) {
  earlyExitFrame.addHighlightedNode(canvasIds[k], "green");
- earlyExitFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
  }
+ earlyExitFrame.nodeLabels = labels;
  earlyExitFrame.addAnnotation("No swaps needed - list is sorted!");
  recorder.recordFrame(earlyExitFrame);
  break;
@@ -299,8 +307,8 @@ public:
  finalFrame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  finalFrame.addHighlightedNode(canvasIds[i], "green");
- finalFrame.nodeLabels[canvasIds[i]] = std::to_string(values[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Bubble Sort Complete!");
  recorder.recordFrame(finalFrame);
  }
@@ -1,4 +1,65 @@
 ﻿#include "frame_recorder.h"
+#include "../visualization/timeline_file.h"
+#include <algorithm>
+
+namespace {
+
+void addOperation(AnimationFrame& target, const std::string& type) {
+    if (type.empty() || type == target.operationType) return;
+    auto& merged = target.mergedOperations;
+    if (std::find(merged.begin(), merged.end(), type) == merged.end()) merged.push_back(type);
+}
+
+// Fold 'frame' into 'target' (same visual state): extend the display time,
+// keep every annotation in order and remember the folded operation types so
+// the operation index still finds the merged frame under each of them.
+void mergeInto(AnimationFrame& target, const AnimationFrame& frame) {
+    target.duration += frame.duration;
+    target.annotations.insert(target.annotations.end(),
+        frame.annotations.begin(), frame.annotations.end());
+    addOperation(target, frame.operationType);
+    for (const auto& type : frame.mergedOperations) addOperation(target, type);
+}
+
+} // namespace
+
+void FrameRecorder::recordFrame(const AnimationFrame& frame) {
+    std::size_t hash = frame.visualHash();
+    if (mergeIdenticalFrames && !frameBuffer.empty() && hash == lastVisualHash &&
+        frameBuffer.back().hasSameVisualState(frame)) {
+        mergeInto(frameBuffer.back(), frame);
+        return;
+    }
+    frameBuffer.push_back(frame);
+    lastVisualHash = hash;
+}
+
+bool FrameRecorder::appendOrMerge(std::vector<AnimationFrame>& frames, const AnimationFrame& frame) {
+    if (!frames.empty() && frames.back().hasSameVisualState(frame)) {
+        mergeInto(frames.back(), frame);
+        return true;
+    }
+    frames.push_back(frame);
+    return false;
+}
+
+std::vector<AnimationFrame> FrameRecorder::compact(const std::vector<AnimationFrame>& frames) {
+    std::vector<AnimationFrame> result;
+    result.reserve(frames.size());
+
+    // Compare hashes first so only real candidates pay for the full comparison
+    std::size_t lastHash = 0;
+    for (const auto& frame : frames) {
+        std::size_t hash = frame.visualHash();
+        if (!result.empty() && hash == lastHash && result.back().hasSameVisualState(frame)) {
+            mergeInto(result.back(), frame);
+            continue;
+        }
+        result.push_back(frame);
+        lastHash = hash;
+    }
+    return result;
+}
 
 // Frame generation helpers for common animation operations.
 // Each function creates an AnimationFrame describing the operation
@@ -11,7 +72,7 @@ AnimationFrame FrameRecorder::generateComparisonFrame(const std::string& elem1,
     frame.duration = defaultDuration;
     frame.nodeColors[elem1] = result ? "green" : "red";
     frame.nodeColors[elem2] = result ? "green" : "red";
-    frameBuffer.push_back(frame);
+    recordFrame(frame);
     return frame;
 }
 
@@ -20,7 +81,7 @@ AnimationFrame FrameRecorder::generateSwapFrame(const std::string& elem1, const
     frame.operationType = "swap";
     frame.highlightedNodes = { elem1, elem2 };
     frame.duration = defaultDuration;
-    frameBuffer.push_back(frame);
+    recordFrame(frame);
     return frame;
 }
 
@@ -32,7 +93,7 @@ AnimationFrame FrameRecorder::generateHighlightFrame(const std::vector<std::stri
     for (const auto& elem : elements) {
         frame.nodeColors[elem] = color;
     }
-    frameBuffer.push_back(frame);
+    recordFrame(frame);
     return frame;
 }
 
@@ -42,7 +103,7 @@ AnimationFrame FrameRecorder::generateTraversalFrame(const std::string& currentN
     frame.highlightedNodes = visitedNodes;
     frame.duration = defaultDuration;
     frame.nodeColors[currentNode] = "blue";
-    frameBuffer.push_back(frame);
+    recordFrame(frame);
     return frame;
 }
 
@@ -52,7 +113,7 @@ AnimationFrame FrameRecorder::generateInsertionFrame(const std::string& newNode,
     frame.highlightedNodes = { newNode };
     frame.duration = defaultDuration;
     frame.nodeColors[newNode] = "yellow";
-    frameBuffer.push_back(frame);
+    recordFrame(frame);
     return frame;
 }
 
@@ -72,7 +133,7 @@ AnimationFrame FrameRecorder::generateNodesFrame(int count) {
     frame.annotations.push_back("Generated " + std::to_string(count) + " nodes");
 
     // Append to the internal buffer and return.
-    frameBuffer.push_back(frame);
+    recordFrame(frame);
     return frame;
 }
 
@@ -80,12 +141,28 @@ std::vector<AnimationFrame> FrameRecorder::getAllFrames() const {
     return frameBuffer;
 }
 
+bool FrameRecorder::saveTimeline(const std::string& path) const {
+    return saveTimeline(frameBuffer, path);
+}
+
+// Stream every frame through a TimelineWriter; keyframes and deltas are
+// chosen by the writer.
+bool FrameRecorder::saveTimeline(const std::vector<AnimationFrame>& frames, const std::string& path) {
+    TimelineWriter writer;
+    if (!writer.open(QString::fromStdString(path))) return false;
+    for (const auto& frame : frames) {
+        if (!writer.append(frame)) return false;
+    }
+    return writer.finish();
+}
+
 // Clear the internal frame buffer. This resets recorded frames.
 void FrameRecorder::reset() {
     frameBuffer.clear();
+    lastVisualHash = 0;
 }
 
 // Alias to clear; kept for API compatibility.
 void FrameRecorder::clear() {
-    frameBuffer.clear();
+    reset();
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <cstddef>
 #include "../visualization/animation_frame.h"
 
 
@@ -12,15 +13,24 @@
 class FrameRecorder {
 private:
  std::vector<AnimationFrame> frameBuffer;
+ std::size_t lastVisualHash = 0; // visualHash() of frameBuffer.back()
 
 public:
  bool interpolationEnabled = false;
+ bool mergeIdenticalFrames = true; // fold repeated visual states into one frame
  int defaultDuration =500; // default frame duration in milliseconds
 
- // Record a prepared frame into the internal buffer.
- void recordFrame(const AnimationFrame& frame) {
- frameBuffer.push_back(frame);
- }
+ // Record a prepared frame into the internal buffer. When it looks exactly
+ // like the previous frame, the previous frame is extended instead.
+ void recordFrame(const AnimationFrame& frame);
+
+ // Append 'frame' to 'frames', merging it into the last frame when both show
+ // the same visual state: durations add up, annotations are concatenated and
+ // the operation type lands in mergedOperations, so nothing the user could
+ // read or seek to is lost. Returns true if it was merged.
+ static bool appendOrMerge(std::vector<AnimationFrame>& frames, const AnimationFrame& frame);
+ // Merge every run of visually identical consecutive frames.
+ static std::vector<AnimationFrame> compact(const std::vector<AnimationFrame>& frames);
 
  // Convenience helpers to create common frame types.
  AnimationFrame generateComparisonFrame(const std::string& elem1, const std::string& elem2, bool result);
@@ -31,6 +41,11 @@ public:
  AnimationFrame generateNodesFrame(int count);
  std::vector<AnimationFrame> getAllFrames() const;
 
+ // Persist recorded frames as a binary timeline file (see timeline_file.h)
+ // so a run can be replayed later without re-executing the algorithm.
+ bool saveTimeline(const std::string& path) const;
+ static bool saveTimeline(const std::vector<AnimationFrame>& frames, const std::string& path);
+
  // Reset/clear the recorded frames.
  void reset();
  void clear();
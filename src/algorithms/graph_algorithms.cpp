@@ -11,7 +11,7 @@ BFSAlgorithm::BFSAlgorithm(GraphStructure* gs) : graphStruct(gs) {}
 void BFSAlgorithm::createFrame(const std::string& operation,
     const std::vector<std::string>& highlighted,
     const std::map<std::string, std::string>& colors,
-    const std::string& annotation) {
+    const FrameAnnotation& annotation) {
     AnimationFrame frame;
     frame.frameNumber = frames.size();
     frame.operationType = operation;
@@ -35,7 +35,7 @@ void BFSAlgorithm::execute() {
         const auto& lastFrame = resultFrames.back();
         QString summary;
         for (const auto& annotation : lastFrame.annotations) {
-            summary += QString::fromStdString(annotation) + "\n";
+            summary += QString::fromStdString(annotation.format()) + "\n";
         }
 
         qDebug() << "BFS completed with" << resultFrames.size() << "frames";
@@ -238,9 +238,9 @@ qDebug() << "BFS:   -> Added to queue, total visited:" << visited.size();
          frame.highlightedEdges.push_back({ current, neighbor });
           frame.nodeColors = colors;
          
-     std::string annotation = found && foundNode == neighbor ?
-       "✓ FOUND! Node: " + neighbor + " has value " + std::to_string(targetValue) :
- "Discovered node: " + neighbor + " from " + current;
+     FrameAnnotation annotation = found && foundNode == neighbor ?
+       FrameAnnotation("✓ FOUND! Node: " + neighbor + " has value " + std::to_string(targetValue)) :
+ FrameAnnotation(FrameAnnotation::Id::DiscoveredNode, neighbor, current);
   
           frame.annotations.push_back(annotation);
         frame.duration = 800;
@@ -260,7 +260,7 @@ qDebug() << "BFS:   -> Added to queue, total visited:" << visited.size();
 
      // Mark current as completely visited
         colors[current] = "#9E9E9E"; // Gray
-        createFrame("VISITED", { current }, colors, "Finished processing node: " + current);
+        createFrame("VISITED", { current }, colors, { FrameAnnotation::Id::FinishedNode, current });
         
         if (found) break; // Stop BFS
     }
@@ -383,7 +383,7 @@ DFSAlgorithm::DFSAlgorithm(GraphStructure* gs) : graphStruct(gs) {}
 void DFSAlgorithm::createFrame(const std::string& operation,
     const std::vector<std::string>& highlighted,
     const std::map<std::string, std::string>& colors,
-    const std::string& annotation) {
+    const FrameAnnotation& annotation) {
     AnimationFrame frame;
     frame.frameNumber = frames.size();
     frame.operationType = operation;
@@ -465,7 +465,7 @@ void DFSAlgorithm::dfsVisit(const std::string& node,
    frame.highlightedEdges.push_back({ node, neighbor });
      frame.nodeColors = colors;
   frame.nodeColors[neighbor] = "#2196F3"; // Blue for next
-      frame.annotations.push_back("Exploring edge: " + node + " → " + neighbor);
+      frame.annotations.push_back({ FrameAnnotation::Id::ExploringEdge, node, neighbor });
  frame.duration = 800;
             frame.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
     std::chrono::system_clock::now().time_since_epoch()
@@ -482,7 +482,7 @@ void DFSAlgorithm::dfsVisit(const std::string& node,
     // Frame: Backtracking (only if not found yet)
     if (!found) {
         colors[node] = "#9E9E9E"; // Gray
-  createFrame("BACKTRACK", { node }, colors, "Backtracking from node: " + node);
+  createFrame("BACKTRACK", { node }, colors, { FrameAnnotation::Id::Backtracking, node });
     }
 }
 
@@ -494,7 +494,7 @@ void DFSAlgorithm::execute() {
         const auto& lastFrame = resultFrames.back();
         QString summary;
         for (const auto& annotation : lastFrame.annotations) {
-            summary += QString::fromStdString(annotation) + "\n";
+            summary += QString::fromStdString(annotation.format()) + "\n";
         }
 
         qDebug() << "DFS completed with" << resultFrames.size() << "frames";
@@ -670,7 +670,7 @@ DijkstraAlgorithm::DijkstraAlgorithm(GraphStructure* gs) : graphStruct(gs) {}
 void DijkstraAlgorithm::createFrame(const std::string& operation,
     const std::vector<std::string>& highlighted,
     const std::map<std::string, std::string>& colors,
-    const std::string& annotation) {
+    const FrameAnnotation& annotation) {
     AnimationFrame frame;
     frame.frameNumber = frames.size();
     frame.operationType = operation;
@@ -693,7 +693,7 @@ void DijkstraAlgorithm::execute() {
         const auto& lastFrame = resultFrames.back();
         QString summary;
         for (const auto& annotation : lastFrame.annotations) {
-            summary += QString::fromStdString(annotation) + "\n";
+            summary += QString::fromStdString(annotation.format()) + "\n";
         }
 
         qDebug() << "Dijkstra completed with" << resultFrames.size() << "frames";
@@ -804,9 +804,7 @@ std::vector<AnimationFrame> DijkstraAlgorithm::executeWithFrames() {
  std::map<std::string, std::string> colors;
             colors[u] = "#4CAF50"; // Green for destination
             
-    std::ostringstream oss;
-            oss << "Found destination: " << u << "\nShortest distance: " << dist[u];
-      createFrame("DESTINATION_FOUND", { u }, colors, oss.str());
+      createFrame("DESTINATION_FOUND", { u }, colors, { FrameAnnotation::Id::FoundDestination, u, dist[u] });
       
    break;  // Stop searching once we found the specific destination
 }
@@ -823,12 +821,11 @@ std::vector<AnimationFrame> DijkstraAlgorithm::executeWithFrames() {
 colors[destNode] = "#2196F3"; // Blue for target
         }
 
-     std::ostringstream oss;
-    oss << "Processing node: " << u << "\nDistance: ";
-        if (d == INF) oss << "∞";
-        else oss << d;
+        FrameAnnotation processMsg = d == INF ?
+            FrameAnnotation(FrameAnnotation::Id::ProcessingDistance, u, "∞") :
+            FrameAnnotation(FrameAnnotation::Id::ProcessingDistance, u, d);
 
-        createFrame("PROCESS", { u }, colors, oss.str());
+        createFrame("PROCESS", { u }, colors, processMsg);
 
         // Check all edges from u
         auto edges = graph->getAllEdges();
@@ -855,11 +852,7 @@ colors[destNode] = "#2196F3"; // Blue for target
           frame.highlightedEdges.push_back({ u, v });
  frame.nodeColors = colors;
 
-  std::ostringstream annotation;
-              annotation << "Relaxing edge: " << u << " → " << v
- << "\nNew distance to " << v << ": " << dist[v]
-            << " (via " << u << ")";
-  frame.annotations.push_back(annotation.str());
+  frame.annotations.push_back({ FrameAnnotation::Id::RelaxingEdge, u, v, dist[v] });
          frame.duration = 1000;
           frame.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
        std::chrono::system_clock::now().time_since_epoch()
@@ -871,7 +864,7 @@ colors[destNode] = "#2196F3"; // Blue for target
 
         // Mark as completely processed
         colors[u] = "#9E9E9E";
-    createFrame("VISITED", { u }, colors, "Finished processing node: " + u);
+    createFrame("VISITED", { u }, colors, { FrameAnnotation::Id::FinishedNode, u });
     }
 
     qDebug() << "Dijkstra: Traversal complete. Visited" << visited.size() << "nodes out of" << nodeIds.size();
@@ -24,7 +24,7 @@ private:
     void createFrame(const std::string& operation,
         const std::vector<std::string>& highlighted,
         const std::map<std::string, std::string>& colors,
-        const std::string& annotation);
+        const FrameAnnotation& annotation);
 
 public:
     BFSAlgorithm(GraphStructure* gs = nullptr);
@@ -43,7 +43,7 @@ private:
     void createFrame(const std::string& operation,
         const std::vector<std::string>& highlighted,
         const std::map<std::string, std::string>& colors,
-        const std::string& annotation);
+        const FrameAnnotation& annotation);
 
     // Internal recursive visit routine used by DFS.
     void dfsVisit(const std::string& node,
@@ -73,7 +73,7 @@ private:
     void createFrame(const std::string& operation,
         const std::vector<std::string>& highlighted,
         const std::map<std::string, std::string>& colors,
-        const std::string& annotation);
+        const FrameAnnotation& annotation);
 
 public:
     DijkstraAlgorithm(GraphStructure* gs = nullptr);
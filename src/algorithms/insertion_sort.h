@@ -94,6 +94,8 @@ private:
  for (const auto& node : nodes) {
  canvasIds.push_back(node.id); // e.g. arr_0, arr_1, ...
  }
+ // Running label table: frames share it and only shifted slots change
+ LabelTable labels = LabelTable::fromValues(canvasIds, data);
 
  // Initial frame: show all elements in blue with values.
  AnimationFrame initialFrame;
@@ -101,8 +103,8 @@ private:
  for (int i =0; i < n; i++) {
  std::string nodeId = canvasIds[i];
  initialFrame.addHighlightedNode(nodeId, "blue");
- initialFrame.nodeLabels[nodeId] = std::to_string(data[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Insertion Sort on array of " + std::to_string(n) + " elements");
  recorder.recordFrame(initialFrame);
 
@@ -114,8 +116,8 @@ private:
  selectKeyFrame.operationType = "Select Key";
  selectKeyFrame.addHighlightedNode(canvasIds[i], "yellow");
  for (int k =0; k < i; k++) selectKeyFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) selectKeyFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- selectKeyFrame.addAnnotation("Iteration " + std::to_string(i) + ": Selected key = " + std::to_string(key));
+ selectKeyFrame.nodeLabels = labels;
+ selectKeyFrame.addAnnotation({ FrameAnnotation::Id::SelectKey, i, key });
  recorder.recordFrame(selectKeyFrame);
 
  int j = i -1;
@@ -126,8 +128,8 @@ private:
  compareFrame.addHighlightedNode(canvasIds[j], "red");
  compareFrame.addHighlightedNode(canvasIds[j +1], "orange");
  for (int k =0; k < j; k++) compareFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) compareFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- compareFrame.addAnnotation("Comparing: arr[" + std::to_string(j) + "]=" + std::to_string(data[j]) + " > key=" + std::to_string(key) + " ? YES - Shift needed");
+ compareFrame.nodeLabels = labels;
+ compareFrame.addAnnotation({ FrameAnnotation::Id::CompareShift, j, data[j], key });
  recorder.recordFrame(compareFrame);
 
  // Shift frame and update data
@@ -136,19 +138,20 @@ private:
  shiftFrame.addHighlightedNode(canvasIds[j], "orange");
  shiftFrame.addHighlightedNode(canvasIds[j +1], "orange");
  for (int k =0; k < j; k++) shiftFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) shiftFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- shiftFrame.addAnnotation("Shifting arr[" + std::to_string(j) + "]=" + std::to_string(data[j]) + " to position " + std::to_string(j +1));
+ shiftFrame.nodeLabels = labels;
+ shiftFrame.addAnnotation({ FrameAnnotation::Id::Shifting, j, data[j], j +1 });
  recorder.recordFrame(shiftFrame);
 
  data[j +1] = data[j];
+ labels.set(canvasIds[j +1], std::to_string(data[j +1]));
  j = j -1;
 
  AnimationFrame afterShiftFrame;
  afterShiftFrame.operationType = "After Shift";
  afterShiftFrame.addHighlightedNode(canvasIds[j +1], "orange");
  for (int k =0; k < j; k++) afterShiftFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) afterShiftFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- afterShiftFrame.addAnnotation("Element shifted to position " + std::to_string(j +1));
+ afterShiftFrame.nodeLabels = labels;
+ afterShiftFrame.addAnnotation({ FrameAnnotation::Id::ShiftedTo, j +1 });
  recorder.recordFrame(afterShiftFrame);
  }
 
@@ -157,18 +160,19 @@ private:
  insertFrame.operationType = "Insert";
  insertFrame.addHighlightedNode(canvasIds[j +1], "cyan");
  for (int k =0; k <= i; k++) if (k != j +1) insertFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) insertFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- insertFrame.addAnnotation("Inserting key=" + std::to_string(key) + " at position " + std::to_string(j +1));
+ insertFrame.nodeLabels = labels;
+ insertFrame.addAnnotation({ FrameAnnotation::Id::InsertKey, key, j +1 });
  recorder.recordFrame(insertFrame);
 
  data[j +1] = key;
+ labels.set(canvasIds[j +1], std::to_string(key));
 
  AnimationFrame afterInsertFrame;
  afterInsertFrame.operationType = "After Insert";
  for (int k =0; k <= i; k++) afterInsertFrame.addHighlightedNode(canvasIds[k], "green");
  for (int k = i +1; k < n; k++) afterInsertFrame.addHighlightedNode(canvasIds[k], "lightgray");
- for (int k =0; k < n; k++) afterInsertFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- afterInsertFrame.addAnnotation("Elements0-" + std::to_string(i) + " are now sorted");
+ afterInsertFrame.nodeLabels = labels;
+ afterInsertFrame.addAnnotation({ FrameAnnotation::Id::PrefixSorted, i });
  recorder.recordFrame(afterInsertFrame);
  }
 
@@ -177,8 +181,8 @@ private:
  finalFrame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  finalFrame.addHighlightedNode(canvasIds[i], "green");
- finalFrame.nodeLabels[canvasIds[i]] = std::to_string(data[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Array is completely sorted!");
  recorder.recordFrame(finalFrame);
 
@@ -199,14 +203,15 @@ private:
 
  int n = values.size();
  if (n ==0) return {};
+ LabelTable labels = LabelTable::fromValues(canvasIds, values);
 
  // Initial frame
  AnimationFrame initialFrame;
  initialFrame.operationType = "Initial State";
  for (int i =0; i < n; i++) {
  initialFrame.addHighlightedNode(canvasIds[i], "blue");
- initialFrame.nodeLabels[canvasIds[i]] = std::to_string(values[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Insertion Sort on list of " + std::to_string(n) + " elements");
  recorder.recordFrame(initialFrame);
 
@@ -217,23 +222,25 @@ private:
  selectKeyFrame.operationType = "Select Key";
  selectKeyFrame.addHighlightedNode(canvasIds[i], "yellow");
  for (int k =0; k < i; k++) selectKeyFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) selectKeyFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
- selectKeyFrame.addAnnotation("Iteration " + std::to_string(i) + ": Selected key = " + std::to_string(key));
+ selectKeyFrame.nodeLabels = labels;
+ selectKeyFrame.addAnnotation({ FrameAnnotation::Id::SelectKey, i, key });
  recorder.recordFrame(selectKeyFrame);
 
  int j = i -1;
  while (j >=0 && values[j] > key) {
  values[j +1] = values[j];
+ labels.set(canvasIds[j +1], std::to_string(values[j +1]));
  j--;
  }
  values[j +1] = key;
+ labels.set(canvasIds[j +1], std::to_string(key));
 
  AnimationFrame afterInsertFrame;
  afterInsertFrame.operationType = "After Insert";
  for (int k =0; k <= i; k++) afterInsertFrame.addHighlightedNode(canvasIds[k], "green");
  for (int k = i +1; k < n; k++) afterInsertFrame.addHighlightedNode(canvasIds[k], "lightgray");
- for (int k =0; k < n; k++) afterInsertFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
- afterInsertFrame.addAnnotation("Elements0-" + std::to_string(i) + " are now sorted");
+ afterInsertFrame.nodeLabels = labels;
+ afterInsertFrame.addAnnotation({ FrameAnnotation::Id::PrefixSorted, i });
  recorder.recordFrame(afterInsertFrame);
  }
 
@@ -246,8 +253,8 @@ private:
  finalFrame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  finalFrame.addHighlightedNode(canvasIds[i], "green");
- finalFrame.nodeLabels[canvasIds[i]] = std::to_string(values[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("List is completely sorted!");
  recorder.recordFrame(finalFrame);
 
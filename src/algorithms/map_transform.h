@@ -46,6 +46,10 @@ public:
  if (ArrayStructure* arr = dynamic_cast<ArrayStructure*>(structure)) {
  auto& data = arr->getData();
  int n = static_cast<int>(data.size());
+ // Running label table: frames share it and only the transformed slot changes
+ std::vector<std::string> nodeIds;
+ for (int i =0; i < n; i++) nodeIds.push_back("node_" + std::to_string(i));
+ LabelTable labels = LabelTable::fromValues(nodeIds, data);
 
  // Initial state frame with element values
  AnimationFrame initialFrame;
@@ -53,8 +57,8 @@ public:
  for (int i =0; i < n; i++) {
  std::string nodeId = "node_" + std::to_string(i);
  initialFrame.addHighlightedNode(nodeId, "blue");
- initialFrame.nodeLabels[nodeId] = std::to_string(data[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Map Transform: value = value * " + std::to_string(multiplier) + " + " + std::to_string(addValue));
  recorder.recordFrame(initialFrame);
 
@@ -62,6 +66,7 @@ public:
  for (int i =0; i < n; i++) {
  int oldValue = data[i];
  data[i] = data[i] * multiplier + addValue;
+ labels.set(nodeIds[i], std::to_string(data[i]));
 
  AnimationFrame transformFrame;
  transformFrame.operationType = "Transform";
@@ -70,9 +75,9 @@ public:
  if (k == i) transformFrame.addHighlightedNode(nodeId, "yellow");
  else if (k < i) transformFrame.addHighlightedNode(nodeId, "green");
  else transformFrame.addHighlightedNode(nodeId, "lightgray");
- transformFrame.nodeLabels[nodeId] = std::to_string(data[k]);
  }
- transformFrame.addAnnotation("Transformed index " + std::to_string(i) + ": " + std::to_string(oldValue) + " -> " + std::to_string(data[i]));
+ transformFrame.nodeLabels = labels;
+ transformFrame.addAnnotation({ FrameAnnotation::Id::TransformedIndex, i, oldValue, data[i] });
  recorder.recordFrame(transformFrame);
  }
 
@@ -82,8 +87,8 @@ public:
  for (int i =0; i < n; i++) {
  std::string nodeId = "node_" + std::to_string(i);
  finalFrame.addHighlightedNode(nodeId, "green");
- finalFrame.nodeLabels[nodeId] = std::to_string(data[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Map Transform Complete!");
  recorder.recordFrame(finalFrame);
  }
@@ -96,6 +101,9 @@ public:
  current = current->next;
  }
  int n = static_cast<int>(values.size());
+ std::vector<std::string> nodeIds;
+ for (int i =0; i < n; i++) nodeIds.push_back("node_" + std::to_string(i));
+ LabelTable labels = LabelTable::fromValues(nodeIds, values);
 
  // Initial state for list
  AnimationFrame initialFrame;
@@ -103,8 +111,8 @@ public:
  for (int i =0; i < n; i++) {
  std::string nodeId = "node_" + std::to_string(i);
  initialFrame.addHighlightedNode(nodeId, "blue");
- initialFrame.nodeLabels[nodeId] = std::to_string(values[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Map Transform: value = value * " + std::to_string(multiplier) + " + " + std::to_string(addValue));
  recorder.recordFrame(initialFrame);
 
@@ -115,6 +123,7 @@ public:
  int oldValue = current->value;
  current->value = current->value * multiplier + addValue;
  values[index] = current->value;
+ labels.set(nodeIds[index], std::to_string(values[index]));
 
  AnimationFrame transformFrame;
  transformFrame.operationType = "Transform";
@@ -123,9 +132,9 @@ public:
  if (k == index) transformFrame.addHighlightedNode(nodeId, "yellow");
  else if (k < index) transformFrame.addHighlightedNode(nodeId, "green");
  else transformFrame.addHighlightedNode(nodeId, "lightgray");
- transformFrame.nodeLabels[nodeId] = std::to_string(values[k]);
  }
- transformFrame.addAnnotation("Transformed node " + std::to_string(index) + ": " + std::to_string(oldValue) + " -> " + std::to_string(current->value));
+ transformFrame.nodeLabels = labels;
+ transformFrame.addAnnotation({ FrameAnnotation::Id::TransformedNode, index, oldValue, current->value });
  recorder.recordFrame(transformFrame);
 
  current = current->next;
@@ -138,8 +147,8 @@ public:
  for (int i =0; i < n; i++) {
  std::string nodeId = "node_" + std::to_string(i);
  finalFrame.addHighlightedNode(nodeId, "green");
- finalFrame.nodeLabels[nodeId] = std::to_string(values[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Map Transform Complete!");
  recorder.recordFrame(finalFrame);
  }
@@ -86,14 +86,19 @@ private:
  auto& data = arr->getData();
  int originalSize = data.size();
 
+ // Running label table: frames share it; an erase only relabels the shifted tail
+ std::vector<std::string> nodeIds;
+ for (int i =0; i < originalSize; i++) nodeIds.push_back("node_" + std::to_string(i));
+ LabelTable labels = LabelTable::fromValues(nodeIds, data);
+
  // Initial state frame
  AnimationFrame initialFrame;
  initialFrame.operationType = "Initial State";
  for (size_t i =0; i < data.size(); i++) {
  std::string nodeId = "node_" + std::to_string(i);
  initialFrame.addHighlightedNode(nodeId, "blue");
- initialFrame.nodeLabels[nodeId] = std::to_string(data[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting RemoveDuplicates on array");
  recorder.recordFrame(initialFrame);
 
@@ -108,8 +113,8 @@ private:
  checkFrame.addHighlightedNode("node_" + std::to_string(position), "yellow");
  // Mark unique elements already processed
  for (size_t i =0; i < position; i++) checkFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- for (size_t i =0; i < data.size(); i++) checkFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
- checkFrame.addAnnotation("Checking: " + std::to_string(*it) + " - Seen before? " + (seen.count(*it) ? "YES" : "NO"));
+ checkFrame.nodeLabels = labels;
+ checkFrame.addAnnotation({ FrameAnnotation::Id::CheckSeen, *it, seen.count(*it) > 0 });
  recorder.recordFrame(checkFrame);
 
  if (seen.count(*it)) {
@@ -118,17 +123,19 @@ private:
  removeFrame.operationType = "Remove Duplicate";
  removeFrame.addHighlightedNode("node_" + std::to_string(position), "red");
  for (size_t i =0; i < position; i++) removeFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- for (size_t i =0; i < data.size(); i++) removeFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
- removeFrame.addAnnotation("Removing duplicate: " + std::to_string(*it));
+ removeFrame.nodeLabels = labels;
+ removeFrame.addAnnotation({ FrameAnnotation::Id::RemovingDuplicate, *it });
  recorder.recordFrame(removeFrame);
 
  it = data.erase(it);
+ for (size_t i = position; i < data.size(); i++) labels.set(nodeIds[i], std::to_string(data[i]));
+ labels.erase(nodeIds[data.size()]);
 
  // Frame: After removal
  AnimationFrame afterRemoveFrame;
  afterRemoveFrame.operationType = "After Removal";
  for (size_t i =0; i < position && i < data.size(); i++) afterRemoveFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- for (size_t i =0; i < data.size(); i++) afterRemoveFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
+ afterRemoveFrame.nodeLabels = labels;
  afterRemoveFrame.addAnnotation("Duplicate removed");
  recorder.recordFrame(afterRemoveFrame);
  } else {
@@ -137,8 +144,8 @@ private:
  keepFrame.operationType = "Keep Element";
  keepFrame.addHighlightedNode("node_" + std::to_string(position), "cyan");
  for (size_t i =0; i <= position && i < data.size(); i++) keepFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- for (size_t i =0; i < data.size(); i++) keepFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
- keepFrame.addAnnotation("Keeping unique element: " + std::to_string(*it));
+ keepFrame.nodeLabels = labels;
+ keepFrame.addAnnotation({ FrameAnnotation::Id::KeepingUnique, *it });
  recorder.recordFrame(keepFrame);
 
  seen.insert(*it);
@@ -152,9 +159,9 @@ private:
  finalFrame.operationType = "Complete";
  for (size_t i =0; i < data.size(); i++) {
  finalFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- finalFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
  }
  int removed = originalSize - data.size();
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Removed " + std::to_string(removed) + " duplicate(s)!");
  recorder.recordFrame(finalFrame);
 
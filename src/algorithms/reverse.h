@@ -79,14 +79,19 @@ private:
  auto& data = arr->getData();
  int n = data.size();
 
+ // Running label table: frames share it and only swapped slots change
+ std::vector<std::string> nodeIds;
+ for (int i =0; i < n; i++) nodeIds.push_back("node_" + std::to_string(i));
+ LabelTable labels = LabelTable::fromValues(nodeIds, data);
+
  // Initial frame showing values
  AnimationFrame initialFrame;
  initialFrame.operationType = "Initial State";
  for (int i =0; i < n; i++) {
  std::string nodeId = "node_" + std::to_string(i);
  initialFrame.addHighlightedNode(nodeId, "blue");
- initialFrame.nodeLabels[nodeId] = std::to_string(data[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Reverse on array of " + std::to_string(n) + " elements");
  recorder.recordFrame(initialFrame);
 
@@ -99,12 +104,14 @@ private:
  selectFrame.addHighlightedNode("node_" + std::to_string(right), "orange");
  for (int i =0; i < left; i++) selectFrame.addHighlightedNode("node_" + std::to_string(i), "green");
  for (int i = right +1; i < n; i++) selectFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- for (int i =0; i < n; i++) selectFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
- selectFrame.addAnnotation("Swapping arr[" + std::to_string(left) + "]=" + std::to_string(data[left]) + " with arr[" + std::to_string(right) + "]=" + std::to_string(data[right]));
+ selectFrame.nodeLabels = labels;
+ selectFrame.addAnnotation({ FrameAnnotation::Id::ReverseSwap, left, data[left], right, data[right] });
  recorder.recordFrame(selectFrame);
 
  // Perform swap
  std::swap(data[left], data[right]);
+ labels.set(nodeIds[left], std::to_string(data[left]));
+ labels.set(nodeIds[right], std::to_string(data[right]));
 
  // Frame: after swap
  AnimationFrame afterSwapFrame;
@@ -113,7 +120,7 @@ private:
  afterSwapFrame.addHighlightedNode("node_" + std::to_string(right), "cyan");
  for (int i =0; i <= left; i++) afterSwapFrame.addHighlightedNode("node_" + std::to_string(i), "green");
  for (int i = right; i < n; i++) afterSwapFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- for (int i =0; i < n; i++) afterSwapFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
+ afterSwapFrame.nodeLabels = labels;
  afterSwapFrame.addAnnotation("Swap complete");
  recorder.recordFrame(afterSwapFrame);
 
@@ -126,8 +133,8 @@ private:
  finalFrame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  finalFrame.addHighlightedNode("node_" + std::to_string(i), "green");
- finalFrame.nodeLabels["node_" + std::to_string(i)] = std::to_string(data[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Array is completely reversed!");
  recorder.recordFrame(finalFrame);
 
@@ -83,6 +83,8 @@ private:
  auto nodes = structure->getNodes();
  std::vector<std::string> canvasIds;
  for (const auto& node : nodes) canvasIds.push_back(node.id);
+ // Running label table: frames share it and only swapped slots change
+ LabelTable labels = LabelTable::fromValues(canvasIds, data);
 
  // Initial state frame
  AnimationFrame initialFrame;
@@ -90,8 +92,8 @@ private:
  for (int i =0; i < n; i++) {
  std::string nodeId = canvasIds[i];
  initialFrame.addHighlightedNode(nodeId, "blue");
- initialFrame.nodeLabels[nodeId] = std::to_string(data[i]);
  }
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Selection Sort on array of " + std::to_string(n) + " elements");
  recorder.recordFrame(initialFrame);
 
@@ -102,8 +104,8 @@ private:
  searchFrame.addHighlightedNode(canvasIds[i], "cyan");
  for (int k =0; k < i; k++) searchFrame.addHighlightedNode(canvasIds[k], "green");
  for (int k = i; k < n; k++) searchFrame.addHighlightedNode(canvasIds[k], "yellow");
- for (int k =0; k < n; k++) searchFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- searchFrame.addAnnotation("Iteration " + std::to_string(i) + ": Searching for minimum in unsorted portion");
+ searchFrame.nodeLabels = labels;
+ searchFrame.addAnnotation({ FrameAnnotation::Id::SearchMinimum, i });
  recorder.recordFrame(searchFrame);
 
  int min_idx = i;
@@ -113,7 +115,7 @@ private:
  compareFrame.addHighlightedNode(canvasIds[min_idx], "red");
  compareFrame.addHighlightedNode(canvasIds[j], "orange");
  for (int k =0; k < i; k++) compareFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) compareFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
+ compareFrame.nodeLabels = labels;
  compareFrame.addAnnotation("Comparing current minimum and candidate");
  recorder.recordFrame(compareFrame);
 
@@ -123,7 +125,7 @@ private:
  newMinFrame.operationType = "New Minimum Found";
  newMinFrame.addHighlightedNode(canvasIds[min_idx], "magenta");
  for (int k =0; k < i; k++) newMinFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) newMinFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
+ newMinFrame.nodeLabels = labels;
  newMinFrame.addAnnotation("New minimum found");
  recorder.recordFrame(newMinFrame);
  }
@@ -135,25 +137,27 @@ private:
  beforeSwapFrame.addHighlightedNode(canvasIds[i], "red");
  beforeSwapFrame.addHighlightedNode(canvasIds[min_idx], "orange");
  for (int k =0; k < i; k++) beforeSwapFrame.addHighlightedNode(canvasIds[k], "green");
- for (int k =0; k < n; k++) beforeSwapFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
+ beforeSwapFrame.nodeLabels = labels;
  beforeSwapFrame.addAnnotation("Swap positions");
  recorder.recordFrame(beforeSwapFrame);
 
  std::swap(data[i], data[min_idx]);
+ labels.set(canvasIds[i], std::to_string(data[i]));
+ labels.set(canvasIds[min_idx], std::to_string(data[min_idx]));
 
  AnimationFrame afterSwapFrame;
  afterSwapFrame.operationType = "After Swap";
  for (int k =0; k <= i; k++) afterSwapFrame.addHighlightedNode(canvasIds[k], "green");
  for (int k = i +1; k < n; k++) afterSwapFrame.addHighlightedNode(canvasIds[k], "lightgray");
- for (int k =0; k < n; k++) afterSwapFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
- afterSwapFrame.addAnnotation("Element placed at position " + std::to_string(i));
+ afterSwapFrame.nodeLabels = labels;
+ afterSwapFrame.addAnnotation({ FrameAnnotation::Id::ElementPlaced, i });
  recorder.recordFrame(afterSwapFrame);
  } else {
  AnimationFrame alreadyMinFrame;
  alreadyMinFrame.operationType = "Already Minimum";
  for (int k =0; k <= i; k++) alreadyMinFrame.addHighlightedNode(canvasIds[k], "green");
  for (int k = i +1; k < n; k++) alreadyMinFrame.addHighlightedNode(canvasIds[k], "lightgray");
- for (int k =0; k < n; k++) alreadyMinFrame.nodeLabels[canvasIds[k]] = std::to_string(data[k]);
+ alreadyMinFrame.nodeLabels = labels;
  alreadyMinFrame.addAnnotation("Element already in correct position");
  recorder.recordFrame(alreadyMinFrame);
  }
@@ -164,8 +168,8 @@ private:
  finalFrame.operationType = "Complete";
  for (int i =0; i < n; i++) {
  finalFrame.addHighlightedNode(canvasIds[i], "green");
- finalFrame.nodeLabels[canvasIds[i]] = std::to_string(data[i]);
  }
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("Array is completely sorted!");
  recorder.recordFrame(finalFrame);
 
@@ -183,11 +187,13 @@ private:
 
  int n = values.size();
  if (n ==0) return {};
+ LabelTable labels = LabelTable::fromValues(canvasIds, values);
 
  // Initial frame
  AnimationFrame initialFrame;
  initialFrame.operationType = "Initial State";
- for (int i =0; i < n; i++) { initialFrame.addHighlightedNode(canvasIds[i], "blue"); initialFrame.nodeLabels[canvasIds[i]] = std::to_string(values[i]); }
+ for (int i =0; i < n; i++) initialFrame.addHighlightedNode(canvasIds[i], "blue");
+ initialFrame.nodeLabels = labels;
  initialFrame.addAnnotation("Starting Selection Sort on list");
  recorder.recordFrame(initialFrame);
 
@@ -197,12 +203,14 @@ private:
  for (int j = i +1; j < n; j++) if (values[j] < values[min_idx]) min_idx = j;
  if (min_idx != i) {
  std::swap(values[i], values[min_idx]);
+ labels.set(canvasIds[i], std::to_string(values[i]));
+ labels.set(canvasIds[min_idx], std::to_string(values[min_idx]));
  AnimationFrame afterSwapFrame;
  afterSwapFrame.operationType = "After Swap";
  for (int k =0; k <= i; k++) afterSwapFrame.addHighlightedNode(canvasIds[k], "green");
  for (int k = i +1; k < n; k++) afterSwapFrame.addHighlightedNode(canvasIds[k], "lightgray");
- for (int k =0; k < n; k++) afterSwapFrame.nodeLabels[canvasIds[k]] = std::to_string(values[k]);
- afterSwapFrame.addAnnotation("Element placed at position " + std::to_string(i));
+ afterSwapFrame.nodeLabels = labels;
+ afterSwapFrame.addAnnotation({ FrameAnnotation::Id::ElementPlaced, i });
  recorder.recordFrame(afterSwapFrame);
  }
  }
@@ -214,7 +222,8 @@ private:
  // Final frame
  AnimationFrame finalFrame;
  finalFrame.operationType = "Complete";
- for (int i =0; i < n; i++) { finalFrame.addHighlightedNode(canvasIds[i], "green"); finalFrame.nodeLabels[canvasIds[i]] = std::to_string(values[i]); }
+ for (int i =0; i < n; i++) finalFrame.addHighlightedNode(canvasIds[i], "green");
+ finalFrame.nodeLabels = labels;
  finalFrame.addAnnotation("List is completely sorted!");
  recorder.recordFrame(finalFrame);
 
@@ -145,7 +145,7 @@ private:
    AnimationFrame visitFrame;
         visitFrame.operationType = "Visit Node";
     visitFrame.addHighlightedNode(canvasId, "cyan");
-     visitFrame.addAnnotation("InOrder visiting node " + std::to_string(node->value) + " (Left ? Root ? Right)");
+     visitFrame.addAnnotation({ FrameAnnotation::Id::TraversalVisit, "InOrder", node->value, "Left ? Root ? Right" });
         recordFrame(visitFrame);
      
    result.push_back(node->value);
@@ -154,7 +154,7 @@ private:
   AnimationFrame processFrame;
         processFrame.operationType = "Process Node";
         processFrame.addHighlightedNode(canvasId, "green");
-     processFrame.addAnnotation("Node " + std::to_string(node->value) + " processed");
+     processFrame.addAnnotation({ FrameAnnotation::Id::NodeProcessed, node->value });
         recordFrame(processFrame);
         
         // Traverse right
@@ -162,7 +162,7 @@ private:
     }
     
     void recordFrame(const AnimationFrame& frame) {
-     frames.push_back(frame);
+     FrameRecorder::appendOrMerge(frames, frame);
     }
 };
 
@@ -149,7 +149,7 @@ private:
         AnimationFrame visitFrame;
         visitFrame.operationType = "Visit Node";
         visitFrame.addHighlightedNode(canvasId, "orange");
-        visitFrame.addAnnotation("PostOrder visiting node " + std::to_string(node->value) + " (Left ? Right ? Root)");
+        visitFrame.addAnnotation({ FrameAnnotation::Id::TraversalVisit, "PostOrder", node->value, "Left ? Right ? Root" });
         recordFrame(visitFrame);
  
    result.push_back(node->value);
@@ -157,12 +157,12 @@ private:
   AnimationFrame processFrame;
   processFrame.operationType = "Process Node";
         processFrame.addHighlightedNode(canvasId, "green");
-        processFrame.addAnnotation("Node " + std::to_string(node->value) + " processed");
+        processFrame.addAnnotation({ FrameAnnotation::Id::NodeProcessed, node->value });
       recordFrame(processFrame);
     }
     
  void recordFrame(const AnimationFrame& frame) {
-        frames.push_back(frame);
+        FrameRecorder::appendOrMerge(frames, frame);
     }
 };
 
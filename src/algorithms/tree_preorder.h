@@ -143,7 +143,7 @@ private:
         AnimationFrame visitFrame;
         visitFrame.operationType = "Visit Node";
  visitFrame.addHighlightedNode(canvasId, "yellow");
-        visitFrame.addAnnotation("PreOrder visiting node " + std::to_string(node->value) + " (Root ? Left ? Right)");
+        visitFrame.addAnnotation({ FrameAnnotation::Id::TraversalVisit, "PreOrder", node->value, "Root ? Left ? Right" });
    recordFrame(visitFrame);
         
 result.push_back(node->value);
@@ -151,7 +151,7 @@ result.push_back(node->value);
      AnimationFrame processFrame;
    processFrame.operationType = "Process Node";
   processFrame.addHighlightedNode(canvasId, "green");
-     processFrame.addAnnotation("Node " + std::to_string(node->value) + " processed");
+     processFrame.addAnnotation({ FrameAnnotation::Id::NodeProcessed, node->value });
   recordFrame(processFrame);
         
         // Then traverse left and right
@@ -160,7 +160,7 @@ result.push_back(node->value);
     }
     
     void recordFrame(const AnimationFrame& frame) {
-        frames.push_back(frame);
+        FrameRecorder::appendOrMerge(frames, frame);
     }
 };
 
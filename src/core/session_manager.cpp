@@ -5,6 +5,7 @@
 #include <QDebug>
 
 const char* SessionManager::SESSION_FILE = "session.json";
+const char* SessionManager::LAYOUT_CACHE_FILE = "layout_cache.json";
 
 // Save complete session with all structures
 void SessionManager::saveCompleteSession(const std::vector<QJsonObject>& structures, const std::string& selectedId) {
@@ -147,4 +148,10 @@ void SessionManager::clearSession() {
         file.remove();
         qDebug() << "Session cleared";
     }
+    QFile::remove(LAYOUT_CACHE_FILE);
+}
+
+// Layout cache file, kept next to the session file
+std::string SessionManager::layoutCachePath() {
+    return LAYOUT_CACHE_FILE;
 }
@@ -59,10 +59,16 @@ public:
     static SessionData loadSession();
     
     /**
-     * @brief Clear session file
+     * @brief Clear session file (and the layout cache saved next to it)
      */
     static void clearSession();
 
+    /**
+     * @brief File the computed layouts are persisted to, next to the session
+     */
+    static std::string layoutCachePath();
+
 private:
     static const char* SESSION_FILE;
+    static const char* LAYOUT_CACHE_FILE;
 };
@@ -1,8 +1,11 @@
 #include <QApplication>
 #include <QGuiApplication>
+#include <QCommandLineParser>
 #include "ui/main_window.h"
+#include "visualization/frame_exporter.h"
 #include <iostream>
 #include <exception>
+#include <cstring>
 #include <QDebug>
 #include <QStyleHints>
 #include <QPalette>
@@ -391,8 +394,65 @@ background-color: #2D3748;
     )";
 }
 
+bool wantsExport(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        // QCommandLineParser takes both "--export file" and "--export=file"
+        if (std::strcmp(argv[i], "--export") == 0 || std::strncmp(argv[i], "--export=", 9) == 0) return true;
+    }
+    return false;
+}
+
+// Batch export of a recorded timeline, without opening any window:
+//   dataviz --export run.dvtl --out frames/ [--format png|gif] [--size 1280x720]
+//           [--from N] [--to N] [--threads N]
+int runExport(int argc, char* argv[]) {
+    // Rendering only needs fonts, so no display is required
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render a recorded timeline to PNG frames or an animated GIF");
+    parser.addHelpOption();
+    QCommandLineOption exportOption("export", "Timeline file (.dvtl) to render.", "timeline");
+    QCommandLineOption outOption("out", "Output directory (png) or file (gif).", "path");
+    QCommandLineOption formatOption("format", "png or gif.", "format", "png");
+    QCommandLineOption sizeOption("size", "Image size as WIDTHxHEIGHT.", "size", "1280x720");
+    QCommandLineOption fromOption("from", "First frame (0-based).", "index", "0");
+    QCommandLineOption toOption("to", "Last frame, -1 for the end.", "index", "-1");
+    QCommandLineOption threadsOption("threads", "Worker threads, 0 for one per core.", "count", "0");
+    for (const auto& option : { exportOption, outOption, formatOption, sizeOption, fromOption, toOption, threadsOption }) parser.addOption(option);
+    parser.process(app);
+
+    FrameExporter::Options options;
+    options.output = parser.value(outOption);
+    options.format = parser.value(formatOption).compare("gif", Qt::CaseInsensitive) == 0 ? FrameExporter::Format::Gif : FrameExporter::Format::PngSequence;
+    options.first = parser.value(fromOption).toInt();
+    options.last = parser.value(toOption).toInt();
+    options.threads = parser.value(threadsOption).toInt();
+    const QStringList size = parser.value(sizeOption).split('x');
+    if (size.size() == 2 && size[0].toInt() > 0 && size[1].toInt() > 0) options.render.size = QSize(size[0].toInt(), size[1].toInt());
+    options.render.font = app.font();
+
+    FrameExporter exporter(options);
+    int reported = -1;
+    exporter.setProgressCallback([&reported](int done, int total) {
+        int percent = total > 0 ? done * 100 / total : 100;
+        if (percent != reported) std::cout << "\rExporting... " << percent << "%" << std::flush;
+        reported = percent;
+        return true;
+    });
+    if (!exporter.exportTimeline(parser.value(exportOption))) {
+        std::cerr << std::endl << "Export failed: " << exporter.errorString().toStdString() << std::endl;
+        return 1;
+    }
+    std::cout << std::endl << "Export written to " << options.output.toStdString() << std::endl;
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     try {
+        if (wantsExport(argc, argv)) return runExport(argc, argv);
+
         std::cout << "Initializing QApplication..." << std::endl;
  qputenv("QTFRAMEWORK_BYPASS_LICENSE_CHECK", "1");
    QApplication app(argc, argv);
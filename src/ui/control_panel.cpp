@@ -127,6 +127,10 @@ QHBoxLayout* playLayout = new QHBoxLayout();
     stepBackwardButton->setFixedSize(btnW_Small, btnH);
     stepBackwardButton->setToolTip("Step Backward");
 
+    reverseButton = new QPushButton("Reverse", this);
+    reverseButton->setFixedSize(btnW_Large, btnH);
+    reverseButton->setToolTip("Play the current animation backwards");
+
     playButton = new QPushButton("Play", this);
     playButton->setFixedSize(btnW_Large, btnH);
     playButton->setObjectName("playButton");
@@ -139,11 +143,54 @@ QHBoxLayout* playLayout = new QHBoxLayout();
   stepForwardButton->setToolTip("Step Forward");
 
     playLayout->addWidget(stepBackwardButton);
+    playLayout->addWidget(reverseButton);
     playLayout->addWidget(playButton);
     playLayout->addWidget(pauseButton);
     playLayout->addWidget(stepForwardButton);
 
     controlLayout->addLayout(playLayout);
+
+    // Timeline scrubber: jump straight to any frame
+    QHBoxLayout* seekLayout = new QHBoxLayout();
+    seekLayout->setSpacing(6);
+
+    seekStartButton = new QPushButton("<<", this);
+    seekStartButton->setFixedSize(btnW_Small - 10, btnH);
+    seekStartButton->setToolTip("Jump to First Frame");
+
+    timelineSlider = new NoScrollSlider(Qt::Horizontal);
+    timelineSlider->setRange(0, 0);
+    timelineSlider->setToolTip("Drag to seek");
+
+    seekEndButton = new QPushButton(">>", this);
+    seekEndButton->setFixedSize(btnW_Small - 10, btnH);
+    seekEndButton->setToolTip("Jump to Last Frame");
+
+    seekLayout->addWidget(seekStartButton);
+    seekLayout->addWidget(timelineSlider, 1);
+    seekLayout->addWidget(seekEndButton);
+    controlLayout->addLayout(seekLayout);
+
+    // Jump to the previous/next frame of a given operation (e.g. a swap)
+    QHBoxLayout* operationLayout = new QHBoxLayout();
+    operationLayout->setSpacing(6);
+
+    prevOperationButton = new QPushButton("<", this);
+    prevOperationButton->setFixedSize(btnW_Small - 15, btnH);
+    prevOperationButton->setToolTip("Previous Occurrence");
+
+    operationCombo = new NoScrollComboBox();
+    operationCombo->setToolTip("Operation to jump to");
+
+    nextOperationButton = new QPushButton(">", this);
+    nextOperationButton->setFixedSize(btnW_Small - 15, btnH);
+    nextOperationButton->setToolTip("Next Occurrence");
+
+    operationLayout->addWidget(prevOperationButton);
+    operationLayout->addWidget(operationCombo, 1);
+    operationLayout->addWidget(nextOperationButton);
+    controlLayout->addLayout(operationLayout);
+
     controlLayout->addSpacing(8);
 
     // Reset button
@@ -159,7 +206,18 @@ QHBoxLayout* playLayout = new QHBoxLayout();
     speedSlider = new NoScrollSlider(Qt::Horizontal);
   speedSlider->setRange(1, 100);
     speedSlider->setValue(50);
-    controlLayout->addWidget(speedSlider);
+
+    // Turbo: several frames per repaint, for long timelines
+    turboButton = new QPushButton("Turbo", this);
+    turboButton->setCheckable(true);
+    turboButton->setFixedSize(btnW_Small, btnH);
+    turboButton->setToolTip("Apply several frames per repaint");
+
+    QHBoxLayout* speedLayout = new QHBoxLayout();
+    speedLayout->setSpacing(6);
+    speedLayout->addWidget(speedSlider, 1);
+    speedLayout->addWidget(turboButton);
+    controlLayout->addLayout(speedLayout);
 
     currentFrameLabel = new QLabel("Frame: 0 / 0");
  currentFrameLabel->setAlignment(Qt::AlignCenter);
@@ -172,12 +230,27 @@ QHBoxLayout* playLayout = new QHBoxLayout();
 void ControlPanel::connectSignals()
 {
     connect(playButton, &QPushButton::clicked, this, &ControlPanel::playClicked);
+    connect(reverseButton, &QPushButton::clicked, this, &ControlPanel::reversePlayClicked);
 connect(pauseButton, &QPushButton::clicked, this, &ControlPanel::pauseClicked);
     connect(resetButton, &QPushButton::clicked, this, &ControlPanel::resetClicked);
     connect(stepForwardButton, &QPushButton::clicked, this, &ControlPanel::stepForwardClicked);
     connect(stepBackwardButton, &QPushButton::clicked, this, &ControlPanel::stepBackwardClicked);
     connect(algorithmCombo, &QComboBox::currentTextChanged, this, &ControlPanel::algorithmSelected);
     connect(speedSlider, &QSlider::valueChanged, this, &ControlPanel::speedChanged);
+    connect(turboButton, &QPushButton::toggled, this, &ControlPanel::turboToggled);
+    connect(timelineSlider, &QSlider::valueChanged, this, &ControlPanel::seekRequested);
+    connect(seekStartButton, &QPushButton::clicked, this, &ControlPanel::seekToStartClicked);
+    connect(seekEndButton, &QPushButton::clicked, this, &ControlPanel::seekToEndClicked);
+    connect(prevOperationButton, &QPushButton::clicked, this, [this]() {
+        if (operationCombo->count() > 0) {
+            emit seekOperationRequested(operationCombo->currentText(), false);
+        }
+    });
+    connect(nextOperationButton, &QPushButton::clicked, this, [this]() {
+        if (operationCombo->count() > 0) {
+            emit seekOperationRequested(operationCombo->currentText(), true);
+        }
+    });
 }
 
 // --- Public methods ---
@@ -223,9 +296,35 @@ if (algorithmCombo->count() == 0) {
 void ControlPanel::setPlayingState(bool playing)
 {
     playButton->setEnabled(!playing);
+    reverseButton->setEnabled(!playing);
     pauseButton->setEnabled(playing);
 }
 
+void ControlPanel::setFramePosition(int index, int count)
+{
+    // Programmatic updates must not echo back as seek requests
+    timelineSlider->blockSignals(true);
+    timelineSlider->setRange(0, qMax(0, count - 1));
+    timelineSlider->setValue(index);
+    timelineSlider->blockSignals(false);
+
+    int shown = count > 0 ? index + 1 : 0;
+    currentFrameLabel->setText(QString("Frame: %1 / %2").arg(shown).arg(count));
+}
+
+void ControlPanel::setOperationTypes(const QStringList& types)
+{
+    QString previous = operationCombo->currentText();
+    operationCombo->clear();
+    operationCombo->addItems(types);
+
+    // Keep the user's choice across runs of the same algorithm
+    int keep = operationCombo->findText(previous);
+    if (keep >= 0) {
+        operationCombo->setCurrentIndex(keep);
+    }
+}
+
 void ControlPanel::enableControls(bool enabled)
 {
     this->setEnabled(enabled);
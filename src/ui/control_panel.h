@@ -9,6 +9,7 @@
 #include <QSpinBox>
 #include <vector>
 #include <QString>
+#include <QStringList>
 
 class ControlPanel : public QWidget
 {
@@ -20,6 +21,10 @@ public:
     void setPlayingState(bool playing);
     void enableControls(bool enabled);
 
+    // Timeline position (scrubber + frame label) and jump targets
+    void setFramePosition(int index, int count);
+    void setOperationTypes(const QStringList& types);
+
     // ⚠️ Remplace populateAlgorithms (obsolète)
     void updateAlgorithmList(const QString& structureType);
     void setupUI();
@@ -27,24 +32,38 @@ public:
 
 signals:
     void playClicked();
+    void reversePlayClicked();
     void pauseClicked();
     void stepForwardClicked();
     void stepBackwardClicked();
     void resetClicked();
     void speedChanged(int speed);
+    void turboToggled(bool enabled);
     void algorithmSelected(QString algorithm);
+    void seekRequested(int frame);
+    void seekToStartClicked();
+    void seekToEndClicked();
+    void seekOperationRequested(QString operationType, bool forward);
 
 private:
     // Boutons
     QPushButton* playButton{nullptr};
+    QPushButton* reverseButton{nullptr};
     QPushButton* pauseButton{nullptr};
     QPushButton* stepForwardButton{nullptr};
     QPushButton* stepBackwardButton{nullptr};
     QPushButton* resetButton{nullptr};
+    QPushButton* seekStartButton{nullptr};
+    QPushButton* seekEndButton{nullptr};
+    QPushButton* prevOperationButton{nullptr};
+    QPushButton* nextOperationButton{nullptr};
+    QPushButton* turboButton{nullptr};
 
     // Controls
     QSlider* speedSlider{nullptr};
     QComboBox* algorithmCombo{nullptr};
+    QSlider* timelineSlider{nullptr};
+    QComboBox* operationCombo{nullptr};
 
     QLabel* currentFrameLabel{nullptr};
 };
\ No newline at end of file
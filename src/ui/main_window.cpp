@@ -10,6 +10,7 @@
 #include "../orchestration/algorithm_manager.h"
 #include "../visualization/animation_frame.h"
 #include "../visualization/visualization_renderer.h"
+#include "../visualization/frame_exporter.h"
 #include "../core/array_structure.h"
 #include "../core/list_structure.h"
 #include "../core/tree_structure.h"
@@ -42,6 +43,10 @@
 #include <QShowEvent>
 #include <QScrollArea>
 #include <QTimer>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QProgressDialog>
+#include <QApplication>
 #include <cmath>
 #include <functional>
 #include <queue>
@@ -86,6 +91,11 @@ MainWindow::MainWindow(QWidget* parent)
   // ⭐ NEW: Connect animation completion to restore UI
     connect(playbackController.get(), &PlaybackController::animationComplete,
 this, &MainWindow::onAnimationComplete);
+    connect(playbackController.get(), &PlaybackController::framesLoaded,
+        this, &MainWindow::onFramesLoaded);
+    connect(playbackController.get(), &PlaybackController::playbackStats,
+        this, &MainWindow::onPlaybackStats);
+    updateTransitionDuration();
 
     setupUI();
     connectSignals();
@@ -281,6 +291,7 @@ void MainWindow::resizeEvent(QResizeEvent* event) {
 
 void MainWindow::connectSignals() {
     connect(controlPanel.get(), &ControlPanel::playClicked, this, &MainWindow::onPlayClicked);
+    connect(controlPanel.get(), &ControlPanel::reversePlayClicked, this, &MainWindow::onReversePlayClicked);
     connect(controlPanel.get(), &ControlPanel::pauseClicked, this, &MainWindow::onPauseClicked);
     connect(controlPanel.get(), &ControlPanel::resetClicked, this, &MainWindow::onResetClicked);
     connect(controlPanel.get(), &ControlPanel::stepForwardClicked, this, &MainWindow::onStepForwardClicked);
@@ -288,6 +299,15 @@ void MainWindow::connectSignals() {
 
     connect(controlPanel.get(), &ControlPanel::algorithmSelected, this, &MainWindow::onAlgorithmSelected);
     connect(controlPanel.get(), &ControlPanel::speedChanged, this, &MainWindow::onSpeedChanged);
+    connect(controlPanel.get(), &ControlPanel::turboToggled, this, &MainWindow::onTurboToggled);
+    connect(controlPanel.get(), &ControlPanel::seekRequested, this, &MainWindow::onSeekRequested);
+    connect(controlPanel.get(), &ControlPanel::seekOperationRequested, this, &MainWindow::onSeekOperationRequested);
+    connect(controlPanel.get(), &ControlPanel::seekToStartClicked,
+        playbackController.get(), &PlaybackController::seekToStart);
+    connect(controlPanel.get(), &ControlPanel::seekToEndClicked,
+        playbackController.get(), &PlaybackController::skipToEnd);
+    connect(playbackController.get(), &PlaybackController::positionChanged,
+        controlPanel.get(), &ControlPanel::setFramePosition);
 
     connect(structureSelector, &StructureSelector::structureSelected,
         this, &MainWindow::onStructureSelected);
@@ -385,6 +405,30 @@ void MainWindow::onPlayClicked() {
     executeAlgorithm(selectedAlgorithm);
 }
 
+void MainWindow::onReversePlayClicked() {
+    // Plays the frames already loaded backwards; nothing is re-run
+    if (!playbackController || playbackController->frameCount() == 0) {
+        qDebug() << "Reverse playback: no animation loaded";
+        return;
+    }
+    if (playbackController->currentIndex() == 0) {
+        qDebug() << "Reverse playback: already at the first frame";
+        return;
+    }
+
+    if (toolboxPanel) {
+        toolboxPanel->setVisible(false);
+    }
+    if (colorLegendPanel && !selectedAlgorithm.empty()) {
+        colorLegendPanel->setAlgorithmLegend(selectedAlgorithm);
+        colorLegendPanel->setVisible(true);
+    }
+
+    controlPanel->setPlayingState(true);
+    isAnimationPlaying = true;
+    playbackController->playReverse();
+}
+
 void MainWindow::onPauseClicked() {
     controlPanel->setPlayingState(false);
     isAnimationPlaying = false;  // NEW: Clear animation state
@@ -423,13 +467,13 @@ void MainWindow::onResetClicked() {
 }
 
 void MainWindow::onStepForwardClicked() {
-    if (playbackController && !currentAnimationFrames.empty()) {
+    if (playbackController && playbackController->frameCount() > 0) {
         playbackController->stepForward();
     }
 }
 
 void MainWindow::onStepBackwardClicked() {
-    if (playbackController && !currentAnimationFrames.empty()) {
+    if (playbackController && playbackController->frameCount() > 0) {
         playbackController->stepBackward();
     }
 }
@@ -443,12 +487,65 @@ void MainWindow::onSpeedChanged(int speed) {
         float playbackSpeed = speed / 50.0f;
         qDebug() << "MainWindow::onSpeedChanged - Converted speed:" << playbackSpeed << "x";
         playbackController->setSpeed(playbackSpeed);
+        updateTransitionDuration();
+    }
+}
+
+void MainWindow::onTurboToggled(bool enabled) {
+    if (playbackController) {
+        playbackController->setTurbo(enabled);
+        updateTransitionDuration();
+    }
+}
+
+void MainWindow::updateTransitionDuration() {
+    // Tween over part of the frame interval so each frame settles before the next
+    if (visualizationPane && playbackController) {
+        // Turbo frames are never on screen long enough to tween
+        int duration = playbackController->isTurbo() ? 0 : playbackController->frameInterval() * 6 / 10;
+        visualizationPane->setTransitionDuration(duration);
+    }
+}
+
+void MainWindow::onSeekRequested(int frame) {
+    if (playbackController && playbackController->frameCount() > 0) {
+        playbackController->seekToFrame(frame);
+    }
+}
+
+void MainWindow::onSeekOperationRequested(QString operationType, bool forward) {
+    if (!playbackController) return;
+    std::string type = operationType.toStdString();
+    bool found = forward ? playbackController->seekToNextOperation(type)
+                         : playbackController->seekToPreviousOperation(type);
+    if (!found) {
+        qDebug() << "No" << (forward ? "later" : "earlier") << operationType << "frame";
+    }
+}
+
+void MainWindow::onFramesLoaded(int count) {
+    QStringList types;
+    for (const auto& type : playbackController->operationTypes()) {
+        types << QString::fromStdString(type);
+    }
+    controlPanel->setOperationTypes(types);
+    controlPanel->setFramePosition(0, count);
+}
+
+void MainWindow::onPlaybackStats(int shown, int dropped, int late) {
+    if (metricsPanel) {
+        metricsPanel->updateMetrics({
+            { "Frames shown", shown },
+            { "Frames dropped", dropped },
+            { "Frames late", late } });
     }
 }
 
 // NEW: Handle animation frame rendering
 void MainWindow::onFrameReady(const AnimationFrame& frame) {
     if (visualizationPane) {
+        // Frames have their own durations, so the tween length follows each one
+        updateTransitionDuration();
         visualizationPane->renderAnimationFrame(frame);
     }
 }
@@ -544,6 +641,9 @@ void MainWindow::executeAlgorithm(const std::string& algorithm) {
 
             // NEW: Execute with animation frames
             currentAnimationFrames = algo->executeWithFrames();
+            // Graph algorithms build their frames without a FrameRecorder;
+            // fold repeated visual states for them too.
+            currentAnimationFrames = FrameRecorder::compact(currentAnimationFrames);
 
             if (currentAnimationFrames.empty()) {
                 // Fallback: algorithm doesn't support animation yet
@@ -642,6 +742,99 @@ void MainWindow::onStructureCreatedFromCode(QString structureId) {
     }
 }
 
+void MainWindow::onSaveRecording() {
+    if (currentAnimationFrames.empty()) {
+        QMessageBox::information(this, "No Recording",
+            "Run an algorithm first, then save its animation as a recording.");
+        return;
+    }
+
+    QString suggested = QString::fromStdString(selectedAlgorithm.empty() ? "recording" : selectedAlgorithm) + ".dvtl";
+    QString path = QFileDialog::getSaveFileName(this, "Save Recording", suggested,
+        "DataViz Timeline (*.dvtl)");
+    if (path.isEmpty()) return;
+
+    if (!FrameRecorder::saveTimeline(currentAnimationFrames, path.toStdString())) {
+        QMessageBox::warning(this, "Save Failed",
+            QString("Could not write the recording to:\n%1").arg(path));
+        return;
+    }
+    qDebug() << "Recording saved:" << path << "(" << currentAnimationFrames.size() << "frames)";
+}
+
+void MainWindow::onOpenRecording() {
+    QString path = QFileDialog::getOpenFileName(this, "Open Recording", QString(),
+        "DataViz Timeline (*.dvtl)");
+    if (path.isEmpty()) return;
+
+    auto reader = std::make_shared<TimelineReader>();
+    if (!reader->open(path)) {
+        QMessageBox::warning(this, "Open Failed",
+            QString("Could not open the recording:\n%1").arg(reader->errorString()));
+        return;
+    }
+
+    // Recordings are replayed onto the structure currently shown in the canvas
+    playbackController->pause();
+    currentAnimationFrames.clear();
+    if (toolboxPanel) {
+        toolboxPanel->setVisible(false);
+    }
+    controlPanel->setPlayingState(true);
+    isAnimationPlaying = true;
+    playbackController->loadTimeline(reader);
+    playbackController->play();
+}
+
+void MainWindow::onExportFrames() {
+    if (currentAnimationFrames.empty()) {
+        QMessageBox::information(this, "No Recording",
+            "Run an algorithm first, then export its animation.");
+        return;
+    }
+
+    QString selectedFilter;
+    QString suggested = QString::fromStdString(selectedAlgorithm.empty() ? "animation" : selectedAlgorithm);
+    QString path = QFileDialog::getSaveFileName(this, "Export Frames", suggested + ".gif",
+        "Animated GIF (*.gif);;PNG Sequence (*.png)", &selectedFilter);
+    if (path.isEmpty()) return;
+
+    // A PNG sequence goes next to the chosen name: <dir>/<name>_00000.png, ...
+    FrameExporter::Options options;
+    QFileInfo target(path);
+    if (selectedFilter.startsWith("PNG")) {
+        options.format = FrameExporter::Format::PngSequence;
+        options.output = target.absolutePath();
+        options.prefix = target.completeBaseName();
+    } else {
+        options.format = FrameExporter::Format::Gif;
+        options.output = path;
+    }
+    options.render.font = font();
+
+    QProgressDialog progressDialog("Exporting frames...", "Cancel", 0, static_cast<int>(currentAnimationFrames.size()), this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(300);
+
+    FrameExporter exporter(options);
+    exporter.setProgressCallback([&progressDialog](int done, int) {
+        progressDialog.setValue(done);
+        QApplication::processEvents();
+        return !progressDialog.wasCanceled();
+    });
+    bool ok = exporter.exportFrames(currentAnimationFrames);
+    progressDialog.reset();
+
+    if (!ok) {
+        // Cancelling is the user's choice, not an error
+        if (exporter.wasCancelled()) return;
+        QMessageBox::warning(this, "Export Failed",
+            QString("Could not export the animation:\n%1").arg(exporter.errorString()));
+        return;
+    }
+    qDebug() << "Frames exported:" << path << "(" << currentAnimationFrames.size() << "frames)";
+}
+
 void MainWindow::onTutorialCompleted() {
     qDebug() << "Tutorial completed";
 }
@@ -678,6 +871,19 @@ void MainWindow::createMenuBar() {
         }
         });
 
+    fileMenu->addSeparator();
+    QAction* openRecordingAction = fileMenu->addAction("Open Recording...");
+    openRecordingAction->setToolTip("Replay a previously saved algorithm run");
+    connect(openRecordingAction, &QAction::triggered, this, &MainWindow::onOpenRecording);
+
+    QAction* saveRecordingAction = fileMenu->addAction("Save Recording...");
+    saveRecordingAction->setToolTip("Save the last algorithm run as a binary timeline");
+    connect(saveRecordingAction, &QAction::triggered, this, &MainWindow::onSaveRecording);
+
+    QAction* exportFramesAction = fileMenu->addAction("Export Frames...");
+    exportFramesAction->setToolTip("Render the last algorithm run to PNG images or an animated GIF");
+    connect(exportFramesAction, &QAction::triggered, this, &MainWindow::onExportFrames);
+
     fileMenu->addSeparator();
     QAction* exitAction = fileMenu->addAction("Exit");
     connect(exitAction, &QAction::triggered, this, &QMainWindow::close);
@@ -942,6 +1148,11 @@ void MainWindow::restorePreviousSession() {
         return;
     }
 
+    // Layouts from the last session let restored structures skip the layout run
+    if (visualizationPane && visualizationPane->getLayoutEngine()) {
+        visualizationPane->getLayoutEngine()->loadCache(SessionManager::layoutCachePath());
+    }
+
     // Try to load complete session
     bool sessionLoaded = dataModelManager->loadSession();
 
@@ -1292,6 +1503,9 @@ void MainWindow::closeEvent(QCloseEvent* event) {
   dataModelManager->saveSession();
             qDebug() << "Session saved on exit (auto-save enabled)";
  }
+        if (visualizationPane && visualizationPane->getLayoutEngine()) {
+            visualizationPane->getLayoutEngine()->saveCache(SessionManager::layoutCachePath());
+        }
     }
     else {
      // **NEW**: Clear session file when auto-save is disabled
@@ -47,16 +47,22 @@ protected:
 private slots:
     void onPlayClicked();
     void onPauseClicked();
+    void onReversePlayClicked();
     void onResetClicked();
     void onStepForwardClicked();
     void onStepBackwardClicked();
 
     void onSpeedChanged(int speed);
+    void onTurboToggled(bool enabled);
     void onAlgorithmSelected(QString algorithm);
     
     // NEW: Animation frame handling
     void onFrameReady(const AnimationFrame& frame);
     void onAnimationComplete();  // ? NEW: Handle animation completion
+    void onFramesLoaded(int count);
+    void onPlaybackStats(int shown, int dropped, int late);
+    void onSeekRequested(int frame);
+    void onSeekOperationRequested(QString operationType, bool forward);
     
     // --- Structure Selector slots ---
     void onStructureSelected(QString structureId);
@@ -65,6 +71,11 @@ private slots:
     // NEW: Code Generator slots
     void onShowCodeGenerator();
     void onStructureCreatedFromCode(QString structureId);
+
+    // Recording (binary timeline) slots
+    void onSaveRecording();
+    void onOpenRecording();
+    void onExportFrames();
   
     // Tutorial slots
     void onTutorialCompleted();
@@ -76,6 +87,7 @@ private:
     void connectSignals();
     void createMenuBar();
     void restorePreviousSession();
+    void updateTransitionDuration();
 
     void executeAlgorithm(const std::string& algorithm);
     void updateVisualizationForStructure(const std::string& structureId);
@@ -27,6 +27,14 @@ VisualizationPane::VisualizationPane(QWidget* parent)
 
     renderer = std::make_unique<VisualizationRenderer>(this);
     layout->addWidget(renderer.get());
+    minimap = new MinimapOverlay(renderer.get());
+
+    annotationLabel = new QLabel(this);
+    annotationLabel->setWordWrap(true);
+    annotationLabel->setAlignment(Qt::AlignCenter);
+    annotationLabel->setStyleSheet("color: #4a5568; font-size: 9pt; padding: 4px;");
+    annotationLabel->hide();
+    layout->addWidget(annotationLabel);
 
     // Set minimum size for the rendering area
     setMinimumSize(600, 400);
@@ -34,6 +42,13 @@ VisualizationPane::VisualizationPane(QWidget* parent)
     interaction = std::make_unique<InteractionManager>();
     layoutEngine = std::make_unique<GraphvizLayoutEngine>();
 
+    // Layouts run off the UI thread; the canvas follows their progress
+    editLayout = std::make_unique<AsyncLayoutRunner>(layoutEngine.get());
+    connect(editLayout.get(), &AsyncLayoutRunner::layoutProgress, this, &VisualizationPane::applyEditLayout);
+    connect(editLayout.get(), &AsyncLayoutRunner::layoutFinished, this, &VisualizationPane::finishEditLayout);
+    treeLayout = std::make_unique<AsyncLayoutRunner>(layoutEngine.get());
+    connect(treeLayout.get(), &AsyncLayoutRunner::layoutFinished, this, [this]() { updateDisplay(); });
+
     updateDisplay();
 }
 
@@ -48,6 +63,9 @@ void VisualizationPane::reset() {
     isLinkingMode = false;
     isEraserMode = false;
     setCursor(Qt::ArrowCursor);
+    editLayout->cancel();
+    treeLayout->cancel();
+    editLayoutIds.clear();
 
     //2. On dit au manager de tout oublier (Nœuds, Arêtes)
     if (interaction) {
@@ -57,9 +75,17 @@ void VisualizationPane::reset() {
     //3. On force un rendu vide pour effacer l'écran
     AnimationFrame emptyFrame;
     renderer->renderFrame(emptyFrame);
+    annotationLabel->clear();
+    annotationLabel->hide();
 }
 // ---------------------------
 
+void VisualizationPane::setTransitionDuration(int ms) {
+    if (renderer) {
+        renderer->setTransitionDuration(ms);
+    }
+}
+
 void VisualizationPane::setRenderSize(int size) {
     if (renderer) {
         float scale = (float)size / 20.0f;
@@ -84,7 +110,9 @@ void VisualizationPane::wheelEvent(QWheelEvent* event) {
         else {
             if (delta > 0) currentZoom *= 1.1f;
             else currentZoom *= 0.9f;
-            if (currentZoom < 0.1f) currentZoom = 0.1f;
+            // Low enough that 40 px nodes shrink below FramePainter's Points
+            // and Clusters thresholds (0.01 -> 0.4 px)
+            if (currentZoom < 0.01f) currentZoom = 0.01f;
             if (currentZoom > 5.0f) currentZoom = 5.0f;
             renderer->setZoomFactor(currentZoom);
         }
@@ -134,13 +162,13 @@ void VisualizationPane::updateDisplay() {
 
         // Priority: local nodeValues > interaction manager values > node id
         if (nodeValues.count(np.id)) {
-            f.nodeLabels[np.id] = nodeValues[np.id];
+            f.nodeLabels.set(np.id, nodeValues[np.id]);
         }
         else if (interactionNodeValues.count(np.id)) {
-            f.nodeLabels[np.id] = std::to_string(interactionNodeValues[np.id]);
+            f.nodeLabels.set(np.id, std::to_string(interactionNodeValues[np.id]));
         }
         else {
-            f.nodeLabels[np.id] = np.id;
+            f.nodeLabels.set(np.id, np.id);
         }
     }
 
@@ -228,7 +256,12 @@ void VisualizationPane::updateDisplay() {
             }
             oss << "}\n";
 
-            auto posMap = layoutEngine->computeLayout(oss.str());
+            // Graphviz runs in the background; canvas positions are shown until it is done.
+            // While an edit layout is moving the nodes the tree would only be laid out again.
+            std::map<std::string, std::pair<double, double>> posMap;
+            if (!layoutEngine->findCachedLayout(oss.str(), posMap) && !editLayout->isRunning()) {
+                treeLayout->start(oss.str());
+            }
             if (!posMap.empty()) {
                 f.nodePositions = posMap;
                 for (const auto& nt : nodeTypeMap) {
@@ -360,28 +393,28 @@ displayFrame.nodeColors.clear();
         }
 
   // ⭐ FIX: Remap node labels from structure IDs to canvas IDs
-        for (const auto& [structNodeId, label] : frame.nodeLabels) {
+        frame.nodeLabels.forEach([&](const std::string& structNodeId, const std::string& label) {
           std::string canvasId = structNodeId;
             
             if (structureToCanvasId.count(structNodeId)) {
                 canvasId = structureToCanvasId[structNodeId];
      }
             
-            displayFrame.nodeLabels[canvasId] = label;
-      }
+            displayFrame.nodeLabels.set(canvasId, label);
+      });
 
         // If the frame doesn't have labels for all nodes, use canvas values
         for (const auto& np : positions) {
             if (!displayFrame.nodeLabels.count(np.id)) {
      // Use value from interaction manager if frame doesn't specify
       if (nodeVals.count(np.id)) {
-        displayFrame.nodeLabels[np.id] = std::to_string(nodeVals[np.id]);
+        displayFrame.nodeLabels.set(np.id, std::to_string(nodeVals[np.id]));
         }
            else if (nodeValues.count(np.id)) {
-      displayFrame.nodeLabels[np.id] = nodeValues[np.id];
+      displayFrame.nodeLabels.set(np.id, nodeValues[np.id]);
          }
   else {
-        displayFrame.nodeLabels[np.id] = np.id;
+        displayFrame.nodeLabels.set(np.id, np.id);
  }
           }
         }
@@ -394,13 +427,20 @@ displayFrame.nodeColors.clear();
         qDebug() << "===================================";
     }
 
-    // Render the complete frame with animation data
-    renderer->renderFrame(displayFrame);
+    // Render the complete frame with animation data, tweening from the previous one
+    renderer->animateToFrame(displayFrame);
+
+    // Annotations are only formatted here, for the frame actually on screen
+    QStringList messages;
+    for (const auto& annotation : frame.annotations) {
+        messages << QString::fromStdString(annotation.format());
+    }
+    annotationLabel->setText(messages.join("\n"));
+    annotationLabel->setVisible(!messages.isEmpty());
 
-    // Log annotations for debugging
-    if (!frame.annotations.empty()) {
+    if (!messages.isEmpty()) {
         qDebug() << "Frame:" << QString::fromStdString(frame.operationType)
-            << "-" << QString::fromStdString(frame.annotations[0]);
+            << "-" << messages.first();
     }
 }
 
@@ -435,6 +475,10 @@ void VisualizationPane::loadStructureForEditing(const std::string& structureId)
     DataStructure* structure = backend->getStructure(structureId);
     if (!structure) return;
 
+    // The previous structure's layout no longer applies
+    editLayout->cancel();
+    editLayoutIds.clear();
+
     // Clear current interactive data
     interaction->clearInteractive();
     nodeValues.clear();
@@ -498,7 +542,28 @@ void VisualizationPane::loadStructureForEditing(const std::string& structureId)
         }
     }
     else {
-        // Random layout for trees and graphs
+        // Trees and graphs: ask the layout engine (Graphviz, or the built-in
+        // force layout without it); random positions until it has answered
+        std::map<std::string, std::pair<double, double>> layout;
+        std::string editDot;
+        if (layoutEngine) {
+            auto quoted = [](const std::string& id) {
+                std::string out = "\"";
+                for (char c : id) {
+                    if (c == '"' || c == '\\') out += '\\';
+                    out += c;
+                }
+                return out + "\"";
+            };
+            std::ostringstream oss;
+            oss << "digraph Structure {\n";
+            for (const auto& node : nodes) oss << "  " << quoted(node.id) << ";\n";
+            for (const auto& edge : edges) oss << "  " << quoted(edge.from) << " -> " << quoted(edge.to) << ";\n";
+            oss << "}\n";
+            // A known layout is used right away, otherwise it settles in the background
+            if (!layoutEngine->findCachedLayout(oss.str(), layout)) editDot = oss.str();
+        }
+
         std::random_device rd;
         std::mt19937 gen(rd());
         std::uniform_real_distribution<> xDis(150.0, 650.0);
@@ -507,8 +572,9 @@ void VisualizationPane::loadStructureForEditing(const std::string& structureId)
         std::map<std::string, std::string> oldToNewId;
 
         for (size_t i = 0; i < nodes.size(); ++i) {
-            double x = xDis(gen);
-            double y = yDis(gen);
+            auto placed = layout.find(nodes[i].id);
+            double x = placed != layout.end() ? placed->second.first : xDis(gen);
+            double y = placed != layout.end() ? placed->second.second : yDis(gen);
 
             std::string newId = interaction->addNode(x, y, shape);
             oldToNewId[nodes[i].id] = newId;
@@ -529,11 +595,32 @@ void VisualizationPane::loadStructureForEditing(const std::string& structureId)
                 interaction->addEdge(oldToNewId[edge.from], oldToNewId[edge.to]);
             }
         }
+
+        if (!editDot.empty()) {
+            editLayoutIds = oldToNewId;
+            editLayout->start(editDot);
+        }
     }
 
     updateDisplay();
 }
 
+void VisualizationPane::applyEditLayout(const LayoutPositions& positions) {
+    std::map<std::string, std::pair<double, double>> canvasPositions;
+    for (const auto& [structureId, pos] : positions) {
+        auto it = editLayoutIds.find(structureId);
+        if (it != editLayoutIds.end()) canvasPositions[it->second] = pos;
+    }
+    interaction->updateNodePositions(canvasPositions);
+    updateDisplay();
+}
+
+void VisualizationPane::finishEditLayout(const LayoutPositions& positions) {
+    applyEditLayout(positions);
+    editLayoutIds.clear();
+    if (interaction->isSyncEnabled()) interaction->saveNodePositionsToStructure();
+}
+
 // --- EVENTS SOURIS ---
 void VisualizationPane::mouseDoubleClickEvent(QMouseEvent* event) {
     QPointF logicalPos = getLogicalPosition(event->pos());
@@ -596,6 +683,8 @@ void VisualizationPane::mousePressEvent(QMouseEvent* event) {
         // Si on clique sur un noeud => Drag & Drop
         if (!clickedId.empty()) {
             if (interaction->startDragging(x, y)) {
+                // The user places nodes by hand from here on
+                editLayout->cancel();
                 setCursor(Qt::ClosedHandCursor);
                 return;
             }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <QWidget>
+#include <QLabel>
 #include <memory>
 #include <vector>
 #include <string>
@@ -7,6 +8,8 @@
 #include "../visualization/visualization_renderer.h"
 #include "../visualization/interaction_manager.h"
 #include "../visualization/GraphvizLayoutEngine.h"
+#include "../visualization/async_layout_runner.h"
+#include "../visualization/minimap_overlay.h"
 
 // Forward declarations
 class MainWindow;
@@ -19,10 +22,13 @@ public:
     ~VisualizationPane();
 
     void setRenderSize(int size);
+    // Duration of the position/color tween between animation frames
+    void setTransitionDuration(int ms);
     void highlightNodes(const std::vector<std::string>& ids, const std::string& color = "red");
     void setInteractionMode(const QString& mode);
     void reset();
     InteractionManager* getInteractionManager() const { return interaction.get(); }
+    GraphvizLayoutEngine* getLayoutEngine() const { return layoutEngine.get(); }
     
     /**
      * @brief Load a structure from the backend into the interactive canvas for editing
@@ -59,6 +65,11 @@ protected:
     void dragEnterEvent(QDragEnterEvent* event) override;
     void dropEvent(QDropEvent* event) override;
 
+private slots:
+    // Edit layout steps arrive keyed by structure node ID
+    void applyEditLayout(const LayoutPositions& positions);
+    void finishEditLayout(const LayoutPositions& positions);
+
 private:
     void updateDisplay();
 
@@ -68,6 +79,16 @@ private:
     std::unique_ptr<VisualizationRenderer> renderer;
     std::unique_ptr<InteractionManager> interaction;
     std::unique_ptr<GraphvizLayoutEngine> layoutEngine;
+    // Background layouts (declared after the engine they use): placing a
+    // structure loaded for editing, and the tree layout of updateDisplay
+    std::unique_ptr<AsyncLayoutRunner> editLayout;
+    std::unique_ptr<AsyncLayoutRunner> treeLayout;
+    std::map<std::string, std::string> editLayoutIds; // structure node ID -> canvas node ID
+
+    // Caption under the canvas with the current frame's annotations
+    QLabel* annotationLabel{nullptr};
+    // Scene overview in the canvas corner (owned by the renderer)
+    MinimapOverlay* minimap{nullptr};
 
     std::vector<std::string> currentHighlights;
 
@@ -1,6 +1,9 @@
 #include "GraphvizLayoutEngine.h"
+#include "multilevel_layout.h"
+#include "layout_cache.h"
+#include <cctype>
+#include <chrono>
 #include <cmath>
-#include <regex>
 #include <sstream>
 #include <vector>
 
@@ -26,7 +29,7 @@
 #endif
 
 GraphvizLayoutEngine::GraphvizLayoutEngine()
- : layoutAlgorithm("dot"), graphvizAvailable(false), gvc(nullptr) {
+ : layoutAlgorithm("dot"), graphvizAvailable(false), gvc(nullptr), cache(std::make_unique<LayoutCache>()) {
 #if USE_GRAPHVIZ
  try {
  gvc = gvContext();
@@ -51,23 +54,74 @@ GraphvizLayoutEngine::~GraphvizLayoutEngine() {
 }
 
 std::map<std::string, std::pair<double, double>> GraphvizLayoutEngine::computeLayout(
- const std::string& dotString) {
+ const std::string& dotString, const ProgressCallback& progress) {
+ std::string algorithm;
+ {
+ std::lock_guard<std::mutex> lock(mutex);
+ algorithm = layoutAlgorithm;
+ }
+ std::vector<std::string> nodes;
+ std::vector<std::pair<int, int>> edges;
+ if (!parseDot(dotString, nodes, edges)) return computeUncachedLayout(dotString, algorithm, nodes, edges, progress);
+
+ // Graphviz and the fallback place the same graph differently, so both go into the key
+ const uint64_t key = LayoutCache::keyOf(nodes, edges, algorithm + (graphvizAvailable ? "/gv" : "/builtin"));
+ {
+ std::lock_guard<std::mutex> lock(mutex);
+ const auto* cached = cache->find(key);
+ if (cached && cached->size() == nodes.size()) return *cached;
+ }
+ auto positions = computeUncachedLayout(dotString, algorithm, nodes, edges, progress);
+ if (!positions.empty()) {
+ std::lock_guard<std::mutex> lock(mutex);
+ cache->insert(key, positions);
+ }
+ return positions;
+}
+
+bool GraphvizLayoutEngine::findCachedLayout(const std::string& dotString,
+ std::map<std::string, std::pair<double, double>>& positions) {
+ std::vector<std::string> nodes;
+ std::vector<std::pair<int, int>> edges;
+ if (!parseDot(dotString, nodes, edges)) return false;
+
+ std::lock_guard<std::mutex> lock(mutex);
+ const uint64_t key = LayoutCache::keyOf(nodes, edges, layoutAlgorithm + (graphvizAvailable ? "/gv" : "/builtin"));
+ const auto* cached = cache->find(key);
+ if (!cached || cached->size() != nodes.size()) return false;
+ positions = *cached;
+ return true;
+}
+
+std::map<std::string, std::pair<double, double>> GraphvizLayoutEngine::computeUncachedLayout(
+ const std::string& dotString, const std::string& algorithm, const std::vector<std::string>& nodes,
+ const std::vector<std::pair<int, int>>& edges, const ProgressCallback& progress) {
+ if (algorithm == "force" || algorithm == "multilevel") {
+ if (nodes.empty()) return {};
+ return computeForceLayout(nodes, edges, algorithm == "multilevel", progress);
+ }
  if (!graphvizAvailable || !gvc) {
- return computeFallbackLayout(dotString);
+ return computeFallbackLayout(dotString, progress);
  }
 
 #if USE_GRAPHVIZ
  try {
+ // One Graphviz context, shared by the layout threads; lookups never wait for it
+ std::unique_lock<std::mutex> lock(gvcMutex);
  GVC_t* ctx = static_cast<GVC_t*>(gvc);
  Agraph_t* g = agmemread(dotString.c_str());
- if (!g) return computeFallbackLayout(dotString);
+ if (!g) {
+ lock.unlock();
+ return computeFallbackLayout(dotString, progress);
+ }
 
  // Attempt layout - if it fails, silently fall back
  // Note: Graphviz may print errors to stderr if plugins are not loaded
- int layoutResult = gvLayout(ctx, g, layoutAlgorithm.c_str());
+ int layoutResult = gvLayout(ctx, g, algorithm.c_str());
  if (layoutResult !=0) {
  agclose(g);
- return computeFallbackLayout(dotString);
+ lock.unlock();
+ return computeFallbackLayout(dotString, progress);
  }
 
  std::map<std::string, std::pair<double, double>> positions;
@@ -87,43 +141,55 @@ std::map<std::string, std::pair<double, double>> GraphvizLayoutEngine::computeLa
  }
  gvFreeLayout(ctx, g);
  agclose(g);
+ lock.unlock();
  if (!positions.empty()) return positions;
  else
- return computeFallbackLayout(dotString);
+ return computeFallbackLayout(dotString, progress);
  } catch (...) {
  // Silently fall back to fallback layout on any exception
  }
 #endif
- return computeFallbackLayout(dotString);
+ return computeFallbackLayout(dotString, progress);
 }
 
 bool GraphvizLayoutEngine::isAvailable() const {
  return graphvizAvailable;
 }
 
+bool GraphvizLayoutEngine::saveCache(const std::string& path) const {
+ std::lock_guard<std::mutex> lock(mutex);
+ return cache->save(path);
+}
+
+bool GraphvizLayoutEngine::loadCache(const std::string& path) {
+ std::lock_guard<std::mutex> lock(mutex);
+ return cache->load(path);
+}
+
+void GraphvizLayoutEngine::clearCache() {
+ std::lock_guard<std::mutex> lock(mutex);
+ cache->clear();
+}
+
 void GraphvizLayoutEngine::setLayoutAlgorithm(const std::string& algo) {
- if (algo == "dot" || algo == "neato" || algo == "fdp" || algo == "circo" || algo == "twopi")
+ std::lock_guard<std::mutex> lock(mutex);
+ if (algo == "dot" || algo == "neato" || algo == "fdp" || algo == "circo" || algo == "twopi" ||
+ algo == "force" || algo == "multilevel")
  layoutAlgorithm = algo;
  else
  layoutAlgorithm = "dot";
 }
 
 std::map<std::string, std::pair<double, double>> GraphvizLayoutEngine::computeFallbackLayout(
- const std::string& dotString) {
+ const std::string& dotString, const ProgressCallback& progress) {
  std::map<std::string, std::pair<double, double>> positions;
- std::regex nodeRegex(R"(\s*(\w+)\s*\[)");
- std::sregex_iterator it(dotString.begin(), dotString.end(), nodeRegex);
- std::sregex_iterator end;
-
  std::vector<std::string> nodes;
- while (it != end) {
- std::string name = it->str(1);
- if (name != "digraph" && name != "graph" && name != "node" &&
- name != "edge" && name != "subgraph" && name != "strict")
- nodes.push_back(name);
- ++it;
- }
- if (nodes.empty()) return positions;
+ std::vector<std::pair<int, int>> edges;
+ if (!parseDot(dotString, nodes, edges)) return positions;
+
+ // A circle only stays readable for a few unconnected nodes
+ if (!edges.empty() || nodes.size() > CIRCLE_MAX_NODES)
+ return computeForceLayout(nodes, edges, nodes.size() >= MULTILEVEL_MIN_NODES, progress);
 
  const double PI =3.14159265358979;
  double r =150.0 + static_cast<double>(nodes.size()) *15.0;
@@ -133,3 +199,133 @@ std::map<std::string, std::pair<double, double>> GraphvizLayoutEngine::computeFa
  }
  return positions;
 }
+
+std::map<std::string, std::pair<double, double>> GraphvizLayoutEngine::computeForceLayout(
+ const std::vector<std::string>& nodes, const std::vector<std::pair<int, int>>& edges, bool multilevel,
+ const ProgressCallback& progress) {
+ if (nodes.empty()) return {};
+
+ // Center on the same point as the circular layout
+ auto centered = [&nodes](const std::vector<ForceLayout::Point>& points) {
+ std::map<std::string, std::pair<double, double>> positions;
+ double cx = 0, cy = 0;
+ for (const auto& p : points) {
+ cx += p.x;
+ cy += p.y;
+ }
+ cx /= points.size();
+ cy /= points.size();
+ for (size_t i = 0; i < nodes.size(); ++i)
+ positions[nodes[i]] = { 400.0 + points[i].x - cx, 300.0 + points[i].y - cy };
+ return positions;
+ };
+
+ // Intermediate positions go out at most every PROGRESS_INTERVAL_MS
+ ForceLayout::ProgressCallback report;
+ if (progress) {
+ auto last = std::chrono::steady_clock::now();
+ report = [&progress, &centered, last](const std::vector<ForceLayout::Point>& points) mutable {
+ auto now = std::chrono::steady_clock::now();
+ if (now - last < std::chrono::milliseconds(PROGRESS_INTERVAL_MS)) return true;
+ last = now;
+ return progress(centered(points));
+ };
+ }
+
+ const int count = static_cast<int>(nodes.size());
+ std::vector<ForceLayout::Point> points;
+ bool cancelled = false;
+ if (multilevel) {
+ MultilevelLayout layout{ MultilevelLayout::Options() };
+ layout.setProgressCallback(report);
+ points = layout.run(count, edges);
+ cancelled = layout.cancelled();
+ }
+ else {
+ ForceLayout layout{ ForceLayout::Options() };
+ layout.setProgressCallback(report);
+ points = layout.run(count, edges);
+ cancelled = layout.cancelled();
+ }
+ if (cancelled) return {};
+ return centered(points);
+}
+
+bool GraphvizLayoutEngine::parseDot(const std::string& dot, std::vector<std::string>& nodes,
+ std::vector<std::pair<int, int>>& edges) {
+ // Tokens: ids (plain or quoted), "->"/"--", "=", and statement ends (; { } newline).
+ // Attribute lists [...] are skipped. Enough for the DOT this application writes.
+ std::map<std::string, int> index;
+ auto nodeIndex = [&](const std::string& name) {
+ auto it = index.find(name);
+ if (it != index.end()) return it->second;
+ index[name] = static_cast<int>(nodes.size());
+ nodes.push_back(name);
+ return static_cast<int>(nodes.size()) - 1;
+ };
+
+ std::vector<std::string> statement;
+ bool hasEdge = false, hasAssign = false;
+ auto endStatement = [&]() {
+ static const char* keywords[] = { "graph", "digraph", "strict", "subgraph", "node", "edge" };
+ bool skip = statement.empty() || hasAssign;
+ for (const char* k : keywords)
+ if (!skip && statement.front() == k) skip = true;
+ if (!skip) {
+ int prev = -1;
+ for (const auto& id : statement) {
+ int cur = nodeIndex(id);
+ if (prev >= 0 && hasEdge) edges.emplace_back(prev, cur);
+ prev = cur;
+ }
+ }
+ statement.clear();
+ hasEdge = hasAssign = false;
+ };
+
+ size_t i = 0;
+ const size_t n = dot.size();
+ while (i < n) {
+ char c = dot[i];
+ if (c == ';' || c == '{' || c == '}' || c == '\n') {
+ endStatement();
+ ++i;
+ }
+ else if (c == '[') {
+ // Skip the attribute list, honoring quoted strings
+ bool quoted = false;
+ for (++i; i < n && (quoted || dot[i] != ']'); ++i) {
+ if (dot[i] == '\\' && quoted) ++i;
+ else if (dot[i] == '"') quoted = !quoted;
+ }
+ ++i;
+ }
+ else if (c == '-' && i + 1 < n && (dot[i + 1] == '>' || dot[i + 1] == '-')) {
+ hasEdge = true;
+ i += 2;
+ }
+ else if (c == '=') {
+ hasAssign = true;
+ ++i;
+ }
+ else if (c == '"') {
+ std::string id;
+ for (++i; i < n && dot[i] != '"'; ++i) {
+ if (dot[i] == '\\' && i + 1 < n) ++i;
+ id += dot[i];
+ }
+ ++i;
+ statement.push_back(id);
+ }
+ else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '-') {
+ size_t start = i++;
+ while (i < n && (std::isalnum(static_cast<unsigned char>(dot[i])) || dot[i] == '_' || dot[i] == '.')) ++i;
+ statement.push_back(dot.substr(start, i - start));
+ }
+ else {
+ ++i;
+ }
+ }
+ endStatement();
+ return !nodes.empty();
+}
@@ -1,28 +1,60 @@
 #pragma once
 
 #include <string>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
+
+class LayoutCache;
 
 /**
  * @class GraphvizLayoutEngine
  * @brief Converts DOT format to node positions using Graphviz when available.
  *
  * This class attempts to use the Graphviz layout engines (dot, neato, etc.)
- * to compute node coordinates from a DOT description. When Graphviz is not
- * available it falls back to a simple circular layout computed locally.
+ * to compute node coordinates from a DOT description. The built-in "force"
+ * (see ForceLayout) and "multilevel" (see MultilevelLayout) algorithms need
+ * no Graphviz; they are also the fallback for graphs with edges or many
+ * nodes, small edgeless ones go on a circle. Results are cached per graph
+ * topology and algorithm (see LayoutCache), so a structure that comes back
+ * is placed without running the layout again. computeLayout may run on
+ * several threads at once. The cache and algorithm name sit behind a short
+ * lock; the Graphviz context has its own lock, held for a whole gvLayout
+ * call, which only computeLayout takes (never findCachedLayout or the cache
+ * persistence), so the UI thread does not wait for a running layout.
  */
 class GraphvizLayoutEngine {
 public:
+    /**
+     * @brief Receives intermediate positions while a built-in layout iterates
+     * @return False to cancel the layout
+     */
+    using ProgressCallback = std::function<bool(const std::map<std::string, std::pair<double, double>>&)>;
+
     GraphvizLayoutEngine();
     ~GraphvizLayoutEngine();
 
     /**
-     * @brief Compute node positions from a DOT string
+     * @brief Compute node positions from a DOT string, or reuse cached ones
+     *
+     * May wait for another thread's Graphviz run; UI code goes through
+     * AsyncLayoutRunner and findCachedLayout instead of calling this.
      * @param dotString DOT format graph description
-     * @return Map of node ID to (x, y) position
+     * @param progress Optional; called at most every PROGRESS_INTERVAL_MS by the
+     *        built-in layouts (Graphviz itself reports nothing and cannot be stopped)
+     * @return Map of node ID to (x, y) position, empty when cancelled
      */
-    std::map<std::string, std::pair<double, double>> computeLayout(const std::string& dotString);
+    std::map<std::string, std::pair<double, double>> computeLayout(const std::string& dotString,
+        const ProgressCallback& progress = nullptr);
+
+    /**
+     * @brief Look up a cached layout without computing one
+     * @return True and fills positions on a hit
+     */
+    bool findCachedLayout(const std::string& dotString, std::map<std::string, std::pair<double, double>>& positions);
 
     /**
      * @brief Returns true if Graphviz libraries are available and initialized
@@ -30,21 +62,66 @@ public:
     bool isAvailable() const;
 
     /**
-     * @brief Select the layout algorithm to use when Graphviz is active
-     * @param algorithm Layout name ("dot", "neato", "fdp", "circo", "twopi")
+     * @brief Select the layout algorithm
+     * @param algorithm Graphviz layout name ("dot", "neato", "fdp", "circo", "twopi")
+     *        or "force" / "multilevel" for the built-in force-directed layouts
      */
     void setLayoutAlgorithm(const std::string& algorithm);
 
+    /**
+     * @brief Persist cached layouts to a JSON file (e.g. next to the session)
+     */
+    bool saveCache(const std::string& path) const;
+
+    /**
+     * @brief Add layouts saved by saveCache to the cache
+     */
+    bool loadCache(const std::string& path);
+
+    void clearCache();
+
 private:
+    // Up to this many edgeless nodes the fallback keeps the circle
+    static constexpr size_t CIRCLE_MAX_NODES = 30;
+    // From this many nodes the fallback coarsens first (MultilevelLayout)
+    static constexpr size_t MULTILEVEL_MIN_NODES = 1000;
+    static constexpr int PROGRESS_INTERVAL_MS = 50;
+
     std::string layoutAlgorithm; ///< Selected layout algorithm name
     bool graphvizAvailable; ///< True when Graphviz context is initialized
 
     void* gvc; ///< Opaque Graphviz context pointer (GVC_t*)
+    std::unique_ptr<LayoutCache> cache; ///< Layouts by topology and algorithm
+    mutable std::mutex mutex; ///< Guards cache and layoutAlgorithm, held briefly
+    std::mutex gvcMutex; ///< Guards gvc for the length of a Graphviz layout
+
+    std::map<std::string, std::pair<double, double>> computeUncachedLayout(const std::string& dotString,
+        const std::string& algorithm, const std::vector<std::string>& nodes,
+        const std::vector<std::pair<int, int>>& edges, const ProgressCallback& progress);
+
+    /**
+     * @brief Fallback layout used when Graphviz is not available
+     * @param dotString DOT format (used to extract node names and edges)
+     * @param progress Passed on to the force-directed layouts
+     * @return Map of node ID to (x, y) position (circle or force-directed)
+     */
+    std::map<std::string, std::pair<double, double>> computeFallbackLayout(const std::string& dotString,
+        const ProgressCallback& progress);
+
+    /**
+     * @brief Built-in force-directed layout, centered like the circular one
+     * @param nodes Node names, in DOT order
+     * @param edges Edges as indices into nodes
+     * @param multilevel Coarsen the graph first (for large graphs)
+     * @return Empty when progress cancelled the layout
+     */
+    std::map<std::string, std::pair<double, double>> computeForceLayout(const std::vector<std::string>& nodes,
+        const std::vector<std::pair<int, int>>& edges, bool multilevel, const ProgressCallback& progress);
 
     /**
-     * @brief Fallback circular layout used when Graphviz is not available
-     * @param dotString DOT format (used to extract node names)
-     * @return Map of node ID to (x, y) position arranged in a circle
+     * @brief Extract node names and edges from a DOT string
+     * @return False when no node was found
      */
-    std::map<std::string, std::pair<double, double>> computeFallbackLayout(const std::string& dotString);
+    static bool parseDot(const std::string& dotString, std::vector<std::string>& nodes,
+        std::vector<std::pair<int, int>>& edges);
 };
@@ -1,9 +1,22 @@
 ﻿#include "animation_frame.h"
 #include <chrono>
+#include <functional>
+
+namespace {
+
+void hashCombine(std::size_t& seed, const std::string& value) {
+    seed ^= std::hash<std::string>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+void hashCombine(std::size_t& seed, double value) {
+    seed ^= std::hash<double>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+} // namespace
 
 // AnimationFrame implementation: simple helpers to build frame contents
 AnimationFrame::AnimationFrame()
-    : frameNumber(0), operationType(""), duration(100), timestamp(0) {
+    : frameNumber(0), operationType(""), duration(500), timestamp(0) {
     timestamp = std::chrono::system_clock::now().time_since_epoch().count();
 }
 
@@ -21,9 +34,9 @@ void AnimationFrame::setNodePosition(const std::string& nodeId, double x, double
     nodePositions[nodeId] = { x, y };
 }
 
-void AnimationFrame::addAnnotation(const std::string& text) {
+void AnimationFrame::addAnnotation(FrameAnnotation annotation) {
     // Use the annotations vector for user-facing messages
-    annotations.push_back(text);
+    annotations.push_back(std::move(annotation));
 }
 
 void AnimationFrame::generateNodes(int count) {
@@ -39,5 +52,46 @@ void AnimationFrame::generateNodes(int count) {
     }
 
     operationType = "GenerateNodes";
-    annotations.push_back("Generated " + std::to_string(count) + " nodes");
+    annotations.emplace_back("Generated " + std::to_string(count) + " nodes");
+}
+
+std::size_t AnimationFrame::visualHash() const {
+    std::size_t seed = 0;
+    for (const auto& id : highlightedNodes) hashCombine(seed, id);
+    hashCombine(seed, "|");
+    for (const auto& e : highlightedEdges) { hashCombine(seed, e.first); hashCombine(seed, e.second); }
+    hashCombine(seed, "|");
+    for (const auto& kv : nodePositions) {
+        hashCombine(seed, kv.first);
+        hashCombine(seed, kv.second.first);
+        hashCombine(seed, kv.second.second);
+    }
+    hashCombine(seed, "|");
+    for (const auto* map : { &nodeColors, &edgeColors, &nodeShapes }) {
+        for (const auto& kv : *map) { hashCombine(seed, kv.first); hashCombine(seed, kv.second); }
+        hashCombine(seed, "|");
+    }
+    nodeLabels.forEach([&seed](const std::string& id, const std::string& label) {
+        hashCombine(seed, id);
+        hashCombine(seed, label);
+    });
+    hashCombine(seed, "|");
+    for (const auto& kv : edgeLabels) { hashCombine(seed, kv.first); hashCombine(seed, kv.second); }
+    hashCombine(seed, "|");
+    for (const auto& e : edges) { hashCombine(seed, e.first); hashCombine(seed, e.second); }
+    hashCombine(seed, dotCode);
+    return seed;
+}
+
+bool AnimationFrame::hasSameVisualState(const AnimationFrame& other) const {
+    return highlightedNodes == other.highlightedNodes &&
+        highlightedEdges == other.highlightedEdges &&
+        nodePositions == other.nodePositions &&
+        nodeColors == other.nodeColors &&
+        edgeColors == other.edgeColors &&
+        nodeShapes == other.nodeShapes &&
+        edges == other.edges &&
+        nodeLabels == other.nodeLabels &&
+        edgeLabels == other.edgeLabels &&
+        dotCode == other.dotCode;
 }
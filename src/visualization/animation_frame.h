@@ -3,6 +3,9 @@
 #include <map>
 #include <vector>
 #include <utility>
+#include <cstddef>
+#include "frame_annotation.h"
+#include "label_table.h"
 
 /**
  * @struct AnimationFrame
@@ -15,6 +18,9 @@
 struct AnimationFrame {
  int frameNumber;
  std::string operationType;
+ // Operation types of later frames merged into this one (see FrameRecorder),
+ // in order and without operationType itself
+ std::vector<std::string> mergedOperations;
 
  // List of node IDs that should be highlighted for this frame.
  std::vector<std::string> highlightedNodes;
@@ -32,12 +38,13 @@ struct AnimationFrame {
  std::map<std::string, std::string> nodeShapes; // nodeId -> shape identifier
  std::vector<std::pair<std::string, std::string>> edges; // explicit edge list
 
- // Optional labels for nodes/edges to show values or annotations
- std::map<std::string, std::string> nodeLabels;
+ // Optional labels for nodes/edges to show values or annotations.
+ // Node labels share an immutable base between frames (see LabelTable).
+ LabelTable nodeLabels;
  std::map<std::string, std::string> edgeLabels;
 
- // Free-form annotations (text messages shown to the user)
- std::vector<std::string> annotations;
+ // Messages shown to the user; formatted lazily (see FrameAnnotation)
+ std::vector<FrameAnnotation> annotations;
 
  // Optional DOT code to supply a layout or fallback visualization
  std::string dotCode;
@@ -53,8 +60,15 @@ struct AnimationFrame {
  void addHighlightedNode(const std::string& nodeId, const std::string& color);
  void addHighlightedEdge(const std::string& from, const std::string& to, const std::string& color);
  void setNodePosition(const std::string& nodeId, double x, double y);
- void addAnnotation(const std::string& text);
+ void addAnnotation(FrameAnnotation annotation);
  void setDuration(int ms);
  void generateNodes(int count);
 
+ // Hash of everything that affects what is drawn (colors, highlights,
+ // positions, shapes, edges, labels, DOT code). Annotations, operation type,
+ // numbering and timing are ignored so frames that only differ in their
+ // message hash equal.
+ std::size_t visualHash() const;
+ bool hasSameVisualState(const AnimationFrame& other) const;
+
 };
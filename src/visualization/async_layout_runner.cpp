@@ -0,0 +1,67 @@
+#include "async_layout_runner.h"
+#include "GraphvizLayoutEngine.h"
+#include <QMetaObject>
+#include <QRunnable>
+#include <functional>
+
+namespace {
+
+class LayoutTask : public QRunnable {
+public:
+    explicit LayoutTask(std::function<void()> work) : work(std::move(work)) {}
+    void run() override { work(); }
+
+private:
+    std::function<void()> work;
+};
+
+} // namespace
+
+AsyncLayoutRunner::AsyncLayoutRunner(GraphvizLayoutEngine* engine, QObject* parent)
+    : QObject(parent), engine(engine) {
+    // A cancelled Graphviz run may still be finishing while the next job starts
+    pool.setMaxThreadCount(2);
+}
+
+AsyncLayoutRunner::~AsyncLayoutRunner() {
+    cancel();
+    pool.waitForDone();
+}
+
+void AsyncLayoutRunner::start(const std::string& dotString) {
+    if (running && dotString == runningDot) return;
+    cancel();
+
+    const int job = ++generation;
+    running = true;
+    runningDot = dotString;
+    cancelFlag = std::make_shared<std::atomic<bool>>(false);
+
+    auto flag = cancelFlag;
+    pool.start(new LayoutTask([this, job, flag, dotString]() {
+        auto progress = [this, job, flag](const LayoutPositions& positions) {
+            if (flag->load()) return false;
+            QMetaObject::invokeMethod(this, [this, job, positions]() {
+                if (job == generation) emit layoutProgress(positions);
+            }, Qt::QueuedConnection);
+            return true;
+        };
+        LayoutPositions positions = engine->computeLayout(dotString, progress);
+        if (flag->load()) return;
+
+        QMetaObject::invokeMethod(this, [this, job, positions]() {
+            if (job != generation) return;
+            running = false;
+            runningDot.clear();
+            if (!positions.empty()) emit layoutFinished(positions);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void AsyncLayoutRunner::cancel() {
+    if (cancelFlag) cancelFlag->store(true);
+    cancelFlag.reset();
+    ++generation;
+    running = false;
+    runningDot.clear();
+}
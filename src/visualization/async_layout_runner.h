@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+class GraphvizLayoutEngine;
+
+using LayoutPositions = std::map<std::string, std::pair<double, double>>;
+
+/**
+ * @class AsyncLayoutRunner
+ * @brief Runs GraphvizLayoutEngine::computeLayout off the UI thread.
+ *
+ * One job at a time: starting a new layout cancels the running one. The
+ * built-in layouts stop at their next progress report; a Graphviz run
+ * cannot be interrupted, its result is just dropped. Signals are emitted on
+ * the runner's thread, layoutProgress at the engine's throttled rate.
+ */
+class AsyncLayoutRunner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AsyncLayoutRunner(GraphvizLayoutEngine* engine, QObject* parent = nullptr);
+    ~AsyncLayoutRunner();
+
+    // Starts laying out the DOT graph; does nothing if that graph is already running
+    void start(const std::string& dotString);
+    void cancel();
+    bool isRunning() const { return running; }
+
+signals:
+    void layoutProgress(const LayoutPositions& positions);
+    void layoutFinished(const LayoutPositions& positions);
+
+private:
+    GraphvizLayoutEngine* engine;
+    QThreadPool pool;
+
+    int generation{ 0 };     // bumped per job; results of older jobs are dropped
+    bool running{ false };
+    std::string runningDot;
+    std::shared_ptr<std::atomic<bool>> cancelFlag;
+};
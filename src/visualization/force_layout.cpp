@@ -0,0 +1,258 @@
+#include "force_layout.h"
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+
+namespace {
+
+constexpr int MAX_TREE_DEPTH = 48;
+constexpr double MIN_DISTANCE = 0.01;
+constexpr double COOLING = 0.95;
+// Convergence must hold this many iterations in a row
+constexpr int CALM_ITERATIONS = 3;
+
+class SliceTask : public QRunnable {
+public:
+    explicit SliceTask(std::function<void()> work) : work(std::move(work)) {}
+    void run() override { work(); }
+
+private:
+    std::function<void()> work;
+};
+
+} // namespace
+
+// Region quadtree over the node positions. Each cell keeps the mass and
+// center of mass of the bodies below it; leaves hold one body, except at
+// MAX_TREE_DEPTH where coincident bodies share a leaf.
+class ForceLayout::QuadTree {
+public:
+    struct Cell {
+        double x, y, size;      // square region
+        double mass{ 0 };
+        double cx{ 0 }, cy{ 0 }; // center of mass
+        int child[4]{ -1, -1, -1, -1 };
+        int body{ -1 };         // leaf body, -1 for internal or empty cells
+        bool leaf{ true };
+    };
+
+    explicit QuadTree(const std::vector<Point>& pos) {
+        double minX = pos[0].x, maxX = pos[0].x, minY = pos[0].y, maxY = pos[0].y;
+        for (const Point& p : pos) {
+            minX = std::min(minX, p.x);
+            maxX = std::max(maxX, p.x);
+            minY = std::min(minY, p.y);
+            maxY = std::max(maxY, p.y);
+        }
+        const double size = std::max(maxX - minX, maxY - minY) + 1.0;
+        cells.reserve(pos.size() * 2);
+        cells.push_back(Cell{ minX, minY, size });
+        for (int i = 0; i < static_cast<int>(pos.size()); ++i) insert(i, pos[i]);
+    }
+
+    const std::vector<Cell>& all() const { return cells; }
+
+private:
+    int quadrantOf(const Cell& cell, const Point& p) const {
+        const double half = cell.size / 2;
+        return (p.x >= cell.x + half ? 1 : 0) + (p.y >= cell.y + half ? 2 : 0);
+    }
+
+    int childFor(int index, int quadrant) {
+        if (cells[index].child[quadrant] < 0) {
+            const Cell& parent = cells[index];
+            const double half = parent.size / 2;
+            Cell child{ parent.x + (quadrant & 1 ? half : 0), parent.y + (quadrant & 2 ? half : 0), half };
+            cells.push_back(child);
+            cells[index].child[quadrant] = static_cast<int>(cells.size()) - 1;
+        }
+        return cells[index].child[quadrant];
+    }
+
+    static void addMass(Cell& cell, const Point& p) {
+        const double mass = cell.mass + 1;
+        cell.cx = (cell.cx * cell.mass + p.x) / mass;
+        cell.cy = (cell.cy * cell.mass + p.y) / mass;
+        cell.mass = mass;
+    }
+
+    void insert(int body, const Point& p) {
+        int index = 0;
+        for (int depth = 0;; ++depth) {
+            Cell& cell = cells[index];
+            if (cell.leaf && cell.mass == 0) {
+                cell.body = body;
+                addMass(cell, p);
+                return;
+            }
+            if (cell.leaf && depth >= MAX_TREE_DEPTH) {
+                addMass(cell, p);
+                return;
+            }
+            if (cell.leaf) {
+                // Split: push the resident body one level down
+                const int resident = cell.body;
+                const Point at{ cell.cx, cell.cy };
+                cell.leaf = false;
+                cell.body = -1;
+                const int quadrant = quadrantOf(cells[index], at);
+                const int down = childFor(index, quadrant);
+                cells[down].body = resident;
+                addMass(cells[down], at);
+            }
+            addMass(cells[index], p);
+            index = childFor(index, quadrantOf(cells[index], p));
+        }
+    }
+
+    std::vector<Cell> cells;
+};
+
+ForceLayout::ForceLayout(const Options& options)
+    : opts(options) {
+}
+
+void ForceLayout::repulse(const QuadTree& tree, const std::vector<Point>& pos, std::vector<Point>& disp, int begin, int end) const {
+    const auto& cells = tree.all();
+    const double k2 = opts.edgeLength * opts.edgeLength;
+    const double theta2 = opts.theta * opts.theta;
+    std::vector<int> stack;
+    stack.reserve(64);
+
+    for (int i = begin; i < end; ++i) {
+        double fx = 0, fy = 0;
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const auto& cell = cells[stack.back()];
+            stack.pop_back();
+            if (cell.mass == 0 || (cell.leaf && cell.body == i && cell.mass == 1)) continue;
+
+            double dx = pos[i].x - cell.cx;
+            double dy = pos[i].y - cell.cy;
+            double d2 = dx * dx + dy * dy;
+            // Far enough (or a leaf): the whole cell acts as one body
+            if (cell.leaf || cell.size * cell.size < theta2 * d2) {
+                double mass = cell.mass - (cell.leaf && cell.body == i ? 1 : 0);
+                if (d2 < MIN_DISTANCE * MIN_DISTANCE) {
+                    // Coincident: push in an arbitrary but stable direction
+                    dx = 0.1 * ((i % 7) - 3);
+                    dy = 0.1 * ((i % 5) - 2) + 0.05;
+                    d2 = dx * dx + dy * dy;
+                }
+                const double scale = k2 * mass / d2; // (k^2 / d) along the unit vector
+                fx += dx * scale;
+                fy += dy * scale;
+                continue;
+            }
+            for (int c : cell.child) {
+                if (c >= 0) stack.push_back(c);
+            }
+        }
+        disp[i].x += fx;
+        disp[i].y += fy;
+    }
+}
+
+std::vector<ForceLayout::Point> ForceLayout::run(int nodeCount, const std::vector<std::pair<int, int>>& edges,
+    std::vector<Point> initial) {
+    lastIterations = 0;
+    wasCancelled = false;
+    if (nodeCount <= 0) return {};
+    const double k = opts.edgeLength;
+
+    std::vector<Point> pos = std::move(initial);
+    if (static_cast<int>(pos.size()) != nodeCount) {
+        // Random start in a square that holds every node at about k spacing
+        std::mt19937 rng(opts.seed);
+        const double side = k * std::sqrt(static_cast<double>(nodeCount));
+        std::uniform_real_distribution<double> coord(0.0, side);
+        pos.resize(nodeCount);
+        for (Point& p : pos) p = { coord(rng), coord(rng) };
+    }
+    if (nodeCount == 1) return pos;
+
+    int threads = opts.threads > 0 ? opts.threads : QThread::idealThreadCount();
+    if (nodeCount < PARALLEL_MIN_NODES) threads = 1;
+    threads = std::max(1, threads);
+    // One pool for the whole run: its threads stay alive between iterations
+    std::unique_ptr<QThreadPool> pool;
+    if (threads > 1) {
+        pool = std::make_unique<QThreadPool>();
+        pool->setMaxThreadCount(threads);
+    }
+
+    double temperature = opts.temperature > 0 ? opts.temperature : 0.1 * k * std::sqrt(static_cast<double>(nodeCount));
+    // Cooling below the tolerance guarantees the loop ends even if forces never balance
+    const double minTemperature = 0.5 * opts.tolerance * k;
+    std::vector<Point> disp(nodeCount);
+    int calm = 0;
+
+    for (int iter = 0; iter < opts.maxIterations; ++iter) {
+        std::fill(disp.begin(), disp.end(), Point{ 0, 0 });
+        const QuadTree tree(pos);
+
+        // Repulsion: each thread owns a contiguous slice of 'disp'
+        if (threads == 1) {
+            repulse(tree, pos, disp, 0, nodeCount);
+        } else {
+            const int chunk = (nodeCount + threads - 1) / threads;
+            for (int t = 0; t < threads; ++t) {
+                const int begin = t * chunk;
+                const int end = std::min(nodeCount, begin + chunk);
+                if (begin >= end) break;
+                pool->start(new SliceTask([this, &tree, &pos, &disp, begin, end]() { repulse(tree, pos, disp, begin, end); }));
+            }
+            pool->waitForDone();
+        }
+
+        // Attraction along edges: (d^2 / k) along the edge
+        for (const auto& [a, b] : edges) {
+            if (a == b || a < 0 || b < 0 || a >= nodeCount || b >= nodeCount) continue;
+            const double dx = pos[a].x - pos[b].x;
+            const double dy = pos[a].y - pos[b].y;
+            const double d = std::sqrt(dx * dx + dy * dy);
+            const double scale = d / k; // d^2 / k along the unit vector
+            disp[a].x -= dx * scale;
+            disp[a].y -= dy * scale;
+            disp[b].x += dx * scale;
+            disp[b].y += dy * scale;
+        }
+
+        // Gravity toward the centroid keeps disconnected parts in view
+        double cx = 0, cy = 0;
+        for (const Point& p : pos) {
+            cx += p.x;
+            cy += p.y;
+        }
+        cx /= nodeCount;
+        cy /= nodeCount;
+
+        // Move each node along its force, by at most the temperature
+        double maxMove = 0;
+        for (int i = 0; i < nodeCount; ++i) {
+            disp[i].x -= opts.gravity * (pos[i].x - cx);
+            disp[i].y -= opts.gravity * (pos[i].y - cy);
+            const double len = std::sqrt(disp[i].x * disp[i].x + disp[i].y * disp[i].y);
+            if (len <= 0) continue;
+            const double step = std::min(len, temperature);
+            pos[i].x += disp[i].x / len * step;
+            pos[i].y += disp[i].y / len * step;
+            maxMove = std::max(maxMove, step);
+        }
+
+        lastIterations = iter + 1;
+        if (progress && !progress(pos)) {
+            wasCancelled = true;
+            break;
+        }
+        temperature = std::max(minTemperature, temperature * COOLING);
+        calm = maxMove < opts.tolerance * k ? calm + 1 : 0;
+        if (calm >= CALM_ITERATIONS) break;
+    }
+    return pos;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ForceLayout
+ * @brief Fruchterman–Reingold force-directed layout with Barnes–Hut repulsion.
+ *
+ * Edges pull their endpoints together (d^2 / k), every pair of nodes
+ * pushes apart (k^2 / d) and a weak gravity keeps components together.
+ * Repulsion is approximated with a quadtree: a cell far enough away
+ * (size / distance < theta) acts as one body at its center of mass, so an
+ * iteration costs O(n log n). Repulsive forces of large graphs are
+ * accumulated on a QThreadPool kept for the whole run. Iterations stop once the largest move
+ * stays under tolerance * k, or after maxIterations. A progress callback
+ * sees the positions after every iteration and can cancel the run.
+ */
+class ForceLayout {
+public:
+    struct Point {
+        double x, y;
+    };
+
+    struct Options {
+        double edgeLength{ 80.0 };   // k, the ideal edge length
+        double theta{ 0.9 };         // Barnes–Hut opening criterion
+        double gravity{ 0.05 };
+        double tolerance{ 0.01 };
+        int maxIterations{ 500 };
+        int threads{ 0 };            // 0: one per core for large graphs
+        unsigned seed{ 1 };          // for the random start
+        double temperature{ 0.0 };   // first step limit, 0: from the node count
+    };
+
+    // Positions after an iteration; returning false cancels the run
+    using ProgressCallback = std::function<bool(const std::vector<Point>&)>;
+
+    explicit ForceLayout(const Options& options);
+
+    void setProgressCallback(ProgressCallback callback) { progress = std::move(callback); }
+
+    // Layout of nodes 0..nodeCount-1. 'initial' seeds the positions when it
+    // has nodeCount entries (e.g. a coarser level); otherwise they start random.
+    std::vector<Point> run(int nodeCount, const std::vector<std::pair<int, int>>& edges,
+        std::vector<Point> initial = {});
+
+    int iterations() const { return lastIterations; }
+    bool cancelled() const { return wasCancelled; }
+
+private:
+    // Below this many nodes one thread is faster than starting workers
+    static constexpr int PARALLEL_MIN_NODES = 2000;
+
+    class QuadTree;
+
+    void repulse(const QuadTree& tree, const std::vector<Point>& pos, std::vector<Point>& disp, int begin, int end) const;
+
+    Options opts;
+    ProgressCallback progress;
+    int lastIterations{ 0 };
+    bool wasCancelled{ false };
+};
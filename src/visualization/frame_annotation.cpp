@@ -0,0 +1,87 @@
+#include "frame_annotation.h"
+#include <cstdio>
+
+namespace {
+
+// Indexed by FrameAnnotation::Id; %1..%4 are replaced by the arguments.
+const char* const TEMPLATES[] = {
+    "%1",
+    "Comparing: %1 and %2",
+    "Swapped: %1 and %2",
+    "Pass %1: Scanning unsorted portion",
+    "Element %1 is now in final position",
+    "Iteration %1: Searching for minimum in unsorted portion",
+    "Element placed at position %1",
+    "Iteration %1: Selected key = %2",
+    "Comparing: arr[%1]=%2 > key=%3 ? YES - Shift needed",
+    "Shifting arr[%1]=%2 to position %3",
+    "Element shifted to position %1",
+    "Inserting key=%1 at position %2",
+    "Elements0-%1 are now sorted",
+    "Swapping arr[%1]=%2 with arr[%3]=%4",
+    "Transformed index %1: %2 -> %3",
+    "Transformed node %1: %2 -> %3",
+    "Checking: %1 - Seen before? %2",
+    "Removing duplicate: %1",
+    "Keeping unique element: %1",
+    "%1 visiting node %2 (%3)",
+    "Node %1 processed",
+    "Discovered node: %1 from %2",
+    "Finished processing node: %1",
+    "Exploring edge: %1 → %2",
+    "Backtracking from node: %1",
+    "Processing node: %1\nDistance: %2",
+    "Relaxing edge: %1 → %2\nNew distance to %2: %3 (via %1)",
+    "Found destination: %1\nShortest distance: %2",
+};
+
+static_assert(sizeof(TEMPLATES) / sizeof(TEMPLATES[0]) ==
+    static_cast<size_t>(FrameAnnotation::Id::Count), "Annotation template table out of sync");
+
+void appendArg(std::string& out, const FrameAnnotation::Arg& arg) {
+    if (const long long* i = std::get_if<long long>(&arg)) {
+        out += std::to_string(*i);
+    } else if (const double* d = std::get_if<double>(&arg)) {
+        // Same rendering as the ostream output the messages used before
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%g", *d);
+        out += buffer;
+    } else if (const char* const* literal = std::get_if<const char*>(&arg)) {
+        if (*literal) out += *literal;
+    } else {
+        out += std::get<std::string>(arg);
+    }
+}
+
+} // namespace
+
+FrameAnnotation::FrameAnnotation(std::string text)
+    : templateId(Id::Text), count(1) {
+    args[0] = std::move(text);
+}
+
+FrameAnnotation::FrameAnnotation(const char* text)
+    : FrameAnnotation(std::string(text ? text : "")) {
+}
+
+std::string FrameAnnotation::format() const {
+    std::string out;
+    for (const char* p = TEMPLATES[static_cast<size_t>(templateId)]; *p; ++p) {
+        if (p[0] == '%' && p[1] >= '1' && p[1] <= '0' + MAX_ARGS) {
+            int index = p[1] - '1';
+            if (index < count) appendArg(out, args[index]);
+            ++p;
+            continue;
+        }
+        out += *p;
+    }
+    return out;
+}
+
+bool FrameAnnotation::operator==(const FrameAnnotation& other) const {
+    if (templateId != other.templateId || count != other.count) return false;
+    for (int i = 0; i < count; ++i) {
+        if (args[i] != other.args[i]) return false;
+    }
+    return true;
+}
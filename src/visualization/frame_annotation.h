@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/**
+ * @class FrameAnnotation
+ * @brief A user-facing frame message stored as a template ID plus arguments.
+ *
+ * Algorithms record thousands of frames that are often never shown (merged,
+ * skipped, or played past at high speed). Instead of building the message
+ * with string concatenation for every frame, a FrameAnnotation keeps the
+ * template ID and up to MAX_ARGS small arguments; format() produces the text
+ * only when the frame is actually displayed.
+ *
+ * Plain strings still convert implicitly (Id::Text) for one-off messages.
+ * const char* arguments are kept as pointers and must be string literals.
+ */
+class FrameAnnotation {
+public:
+    enum class Id : uint16_t {
+        Text,               // %1 (free-form text)
+        // Sorting
+        Comparing,          // Comparing: %1 and %2
+        Swapped,            // Swapped: %1 and %2
+        PassStart,          // Pass %1: Scanning unsorted portion
+        ElementSorted,      // Element %1 is now in final position
+        SearchMinimum,      // Iteration %1: Searching for minimum in unsorted portion
+        ElementPlaced,      // Element placed at position %1
+        SelectKey,          // Iteration %1: Selected key = %2
+        CompareShift,       // Comparing: arr[%1]=%2 > key=%3 ? YES - Shift needed
+        Shifting,           // Shifting arr[%1]=%2 to position %3
+        ShiftedTo,          // Element shifted to position %1
+        InsertKey,          // Inserting key=%1 at position %2
+        PrefixSorted,       // Elements0-%1 are now sorted
+        // Transforms
+        ReverseSwap,        // Swapping arr[%1]=%2 with arr[%3]=%4
+        TransformedIndex,   // Transformed index %1: %2 -> %3
+        TransformedNode,    // Transformed node %1: %2 -> %3
+        CheckSeen,          // Checking: %1 - Seen before? %2
+        RemovingDuplicate,  // Removing duplicate: %1
+        KeepingUnique,      // Keeping unique element: %1
+        // Trees
+        TraversalVisit,     // %1 visiting node %2 (%3)
+        NodeProcessed,      // Node %1 processed
+        // Graphs
+        DiscoveredNode,     // Discovered node: %1 from %2
+        FinishedNode,       // Finished processing node: %1
+        ExploringEdge,      // Exploring edge: %1 → %2
+        Backtracking,       // Backtracking from node: %1
+        ProcessingDistance, // Processing node: %1\nDistance: %2
+        RelaxingEdge,       // Relaxing edge: %1 → %2\nNew distance to %2: %3 (via %1)
+        FoundDestination,   // Found destination: %1\nShortest distance: %2
+        Count
+    };
+
+    // long long for integers, double for reals, const char* for literals,
+    // std::string for runtime text (short ids stay in the SSO buffer).
+    using Arg = std::variant<long long, double, const char*, std::string>;
+    static constexpr int MAX_ARGS = 4;
+
+    FrameAnnotation() = default;
+    FrameAnnotation(std::string text);
+    FrameAnnotation(const char* text);
+
+    template <typename... Args>
+    FrameAnnotation(Id id, Args&&... args) : templateId(id) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Too many annotation arguments");
+        (push(std::forward<Args>(args)), ...);
+    }
+
+    Id id() const { return templateId; }
+    int argCount() const { return count; }
+    const Arg& arg(int index) const { return args[index]; }
+
+    // Build the user-visible text. Only call this when showing the message.
+    std::string format() const;
+
+    bool operator==(const FrameAnnotation& other) const;
+    bool operator!=(const FrameAnnotation& other) const { return !(*this == other); }
+
+private:
+    template <typename T>
+    void push(T&& value) {
+        using D = std::decay_t<T>;
+        if constexpr (std::is_same_v<D, bool>) {
+            args[count++] = static_cast<const char*>(value ? "YES" : "NO");
+        } else if constexpr (std::is_integral_v<D>) {
+            args[count++] = static_cast<long long>(value);
+        } else if constexpr (std::is_floating_point_v<D>) {
+            args[count++] = static_cast<double>(value);
+        } else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+            args[count++] = static_cast<const char*>(value);
+        } else {
+            args[count++] = std::string(std::forward<T>(value));
+        }
+    }
+
+    Id templateId{Id::Text};
+    uint8_t count{0};
+    std::array<Arg, MAX_ARGS> args{};
+};
@@ -0,0 +1,111 @@
+#include "frame_delta.h"
+
+namespace {
+
+template <typename T, typename C>
+void diffField(const T& from, const T& to, std::optional<C>& change) {
+    if (from != to) change = C{ from, to };
+}
+
+template <typename T, typename C>
+void stepField(T& field, const std::optional<C>& change, bool forward) {
+    if (change) field = forward ? change->after : change->before;
+}
+
+} // namespace
+
+template <typename V>
+FrameDelta::MapChanges<V> FrameDelta::diffMaps(const std::map<std::string, V>& from, const std::map<std::string, V>& to) {
+    // Both maps are sorted: one merge pass finds removed, added and changed keys
+    MapChanges<V> changes;
+    auto i = from.begin();
+    auto j = to.begin();
+    while (i != from.end() || j != to.end()) {
+        if (j == to.end() || (i != from.end() && i->first < j->first)) {
+            changes.push_back({ i->first, i->second, std::nullopt });
+            ++i;
+        } else if (i == from.end() || j->first < i->first) {
+            changes.push_back({ j->first, std::nullopt, j->second });
+            ++j;
+        } else {
+            if (!(i->second == j->second)) changes.push_back({ i->first, i->second, j->second });
+            ++i;
+            ++j;
+        }
+    }
+    return changes;
+}
+
+template <typename V>
+void FrameDelta::applyMap(std::map<std::string, V>& map, const MapChanges<V>& changes, bool forward) {
+    for (const auto& change : changes) {
+        const std::optional<V>& value = forward ? change.after : change.before;
+        if (value) map[change.key] = *value;
+        else map.erase(change.key);
+    }
+}
+
+FrameDelta FrameDelta::between(const AnimationFrame& from, const AnimationFrame& to) {
+    FrameDelta delta;
+    delta.frameNumber = { from.frameNumber, to.frameNumber };
+    delta.duration = { from.duration, to.duration };
+    delta.timestamp = { from.timestamp, to.timestamp };
+
+    diffField(from.operationType, to.operationType, delta.operationType);
+    diffField(from.mergedOperations, to.mergedOperations, delta.mergedOperations);
+    diffField(from.highlightedNodes, to.highlightedNodes, delta.highlightedNodes);
+    diffField(from.highlightedEdges, to.highlightedEdges, delta.highlightedEdges);
+    diffField(from.edges, to.edges, delta.edges);
+    diffField(from.annotations, to.annotations, delta.annotations);
+    diffField(from.dotCode, to.dotCode, delta.dotCode);
+
+    delta.nodePositions = diffMaps(from.nodePositions, to.nodePositions);
+    delta.nodeColors = diffMaps(from.nodeColors, to.nodeColors);
+    delta.edgeColors = diffMaps(from.edgeColors, to.edgeColors);
+    delta.nodeShapes = diffMaps(from.nodeShapes, to.nodeShapes);
+    delta.edgeLabels = diffMaps(from.edgeLabels, to.edgeLabels);
+
+    // Frames from the same run share a label base, so this only walks overrides
+    from.nodeLabels.diff(to.nodeLabels, [&delta](const std::string& id, const std::string* before, const std::string* after) {
+        KeyChange<std::string> change{ id, std::nullopt, std::nullopt };
+        if (before) change.before = *before;
+        if (after) change.after = *after;
+        delta.nodeLabels.push_back(std::move(change));
+    });
+
+    return delta;
+}
+
+void FrameDelta::step(AnimationFrame& frame, bool forward) const {
+    frame.frameNumber = forward ? frameNumber.after : frameNumber.before;
+    frame.duration = forward ? duration.after : duration.before;
+    frame.timestamp = forward ? timestamp.after : timestamp.before;
+
+    stepField(frame.operationType, operationType, forward);
+    stepField(frame.mergedOperations, mergedOperations, forward);
+    stepField(frame.highlightedNodes, highlightedNodes, forward);
+    stepField(frame.highlightedEdges, highlightedEdges, forward);
+    stepField(frame.edges, edges, forward);
+    stepField(frame.annotations, annotations, forward);
+    stepField(frame.dotCode, dotCode, forward);
+
+    applyMap(frame.nodePositions, nodePositions, forward);
+    applyMap(frame.nodeColors, nodeColors, forward);
+    applyMap(frame.edgeColors, edgeColors, forward);
+    applyMap(frame.nodeShapes, nodeShapes, forward);
+    applyMap(frame.edgeLabels, edgeLabels, forward);
+
+    for (const auto& change : nodeLabels) {
+        const std::optional<std::string>& value = forward ? change.after : change.before;
+        if (value) frame.nodeLabels.set(change.key, *value);
+        else frame.nodeLabels.erase(change.key);
+    }
+}
+
+void FrameDelta::apply(AnimationFrame& frame) const {
+    step(frame, true);
+}
+
+void FrameDelta::revert(AnimationFrame& frame) const {
+    step(frame, false);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "animation_frame.h"
+
+/**
+ * @class FrameDelta
+ * @brief Invertible difference between two consecutive animation frames.
+ *
+ * Every change records both the old and the new value, so the same delta
+ * moves a frame forward (apply) or backward (revert) at the same cost.
+ * PlaybackController keeps a running frame plus one delta per step, which
+ * makes reverse playback as cheap as forward playback without holding a
+ * full snapshot per frame.
+ */
+class FrameDelta {
+public:
+    // Delta that turns 'from' into 'to'
+    static FrameDelta between(const AnimationFrame& from, const AnimationFrame& to);
+
+    void apply(AnimationFrame& frame) const;
+    void revert(AnimationFrame& frame) const;
+
+private:
+    // Whole-field replacement for small fields (lists, strings, numbers)
+    template <typename T>
+    struct Change {
+        T before;
+        T after;
+    };
+
+    // Per-key change of a map; nullopt means the key is absent
+    template <typename V>
+    struct KeyChange {
+        std::string key;
+        std::optional<V> before;
+        std::optional<V> after;
+    };
+
+    template <typename V>
+    using MapChanges = std::vector<KeyChange<V>>;
+
+    template <typename V>
+    static MapChanges<V> diffMaps(const std::map<std::string, V>& from, const std::map<std::string, V>& to);
+    template <typename V>
+    static void applyMap(std::map<std::string, V>& map, const MapChanges<V>& changes, bool forward);
+
+    void step(AnimationFrame& frame, bool forward) const;
+
+    Change<int> frameNumber{};
+    Change<int> duration{};
+    Change<long long> timestamp{};
+    std::optional<Change<std::string>> operationType;
+    std::optional<Change<std::vector<std::string>>> mergedOperations;
+    std::optional<Change<std::vector<std::string>>> highlightedNodes;
+    std::optional<Change<std::vector<std::pair<std::string, std::string>>>> highlightedEdges;
+    std::optional<Change<std::vector<std::pair<std::string, std::string>>>> edges;
+    std::optional<Change<std::vector<FrameAnnotation>>> annotations;
+    std::optional<Change<std::string>> dotCode;
+
+    MapChanges<std::pair<double, double>> nodePositions;
+    MapChanges<std::string> nodeColors;
+    MapChanges<std::string> edgeColors;
+    MapChanges<std::string> nodeShapes;
+    MapChanges<std::string> nodeLabels;
+    MapChanges<std::string> edgeLabels;
+};
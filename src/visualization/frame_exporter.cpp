@@ -0,0 +1,236 @@
+#include "frame_exporter.h"
+#include "gif_encoder.h"
+#include "timeline_file.h"
+#include <QColor>
+#include <QDebug>
+#include <QDir>
+#include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+
+// Frames of one export chunk: either borrowed from memory or decoded from a
+// timeline. TimelineReader caches its last frame and is not thread-safe, so
+// every chunk maps the file on its own.
+class FrameExporter::FrameSource {
+public:
+    explicit FrameSource(const std::vector<AnimationFrame>* frames = nullptr) : frames(frames) {}
+
+    bool open(const QString& path) { return reader.open(path); }
+    QString errorString() const { return reader.errorString(); }
+
+    AnimationFrame frameAt(int index) { return frames ? (*frames)[index] : reader.frameAt(index); }
+
+private:
+    const std::vector<AnimationFrame>* frames;
+    TimelineReader reader;
+};
+
+namespace {
+
+constexpr int PROGRESS_POLL_MS = 50;
+constexpr int LUT_SIZE = 1 << 15;
+
+class ExportTask : public QRunnable {
+public:
+    explicit ExportTask(std::function<void()> work) : work(std::move(work)) {}
+    void run() override { work(); }
+
+private:
+    std::function<void()> work;
+};
+
+// GIF frames share one global palette: a 6x6x6 color cube, the colors the
+// canvas itself draws with, and a gray ramp for antialiased edges
+std::array<uint32_t, 256> gifPalette() {
+    std::array<uint32_t, 256> palette{};
+    int count = 0;
+    const char* canvasColors[] = { "#FFFFFF", "#000000", "#F0F0F0", "#2C3E50", "#E74C3C", "#E3F2FD", "#3498DB",
+        "#FFD700", "#9E9E9E", "#4CAF50", "#2196F3", "#FF9800", "#FF6B6B" };
+    for (const char* name : canvasColors) palette[count++] = QColor(name).rgb() & 0xffffff;
+
+    for (int r = 0; r < 6; ++r) {
+        for (int g = 0; g < 6; ++g) {
+            for (int b = 0; b < 6; ++b) palette[count++] = (r * 51 << 16) | (g * 51 << 8) | (b * 51);
+        }
+    }
+
+    const int grays = 256 - count;
+    for (int i = 1; count < 256; ++i) {
+        int v = i * 255 / (grays + 1);
+        palette[count++] = (v << 16) | (v << 8) | v;
+    }
+    return palette;
+}
+
+// Nearest palette entry for every 15-bit color, so quantizing is one lookup per pixel
+std::vector<uint8_t> gifLookup(const std::array<uint32_t, 256>& palette) {
+    std::vector<uint8_t> lut(LUT_SIZE);
+    for (int key = 0; key < LUT_SIZE; ++key) {
+        int r = ((key >> 10) & 31) * 255 / 31;
+        int g = ((key >> 5) & 31) * 255 / 31;
+        int b = (key & 31) * 255 / 31;
+        int best = 0;
+        int bestDistance = INT_MAX;
+        for (int i = 0; i < 256; ++i) {
+            int dr = r - static_cast<int>((palette[i] >> 16) & 0xff);
+            int dg = g - static_cast<int>((palette[i] >> 8) & 0xff);
+            int db = b - static_cast<int>(palette[i] & 0xff);
+            // Weighted toward green, which the eye resolves best
+            int distance = 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = i;
+            }
+        }
+        lut[key] = static_cast<uint8_t>(best);
+    }
+    return lut;
+}
+
+std::vector<uint8_t> quantize(const QImage& image, const std::vector<uint8_t>& lut) {
+    const QImage rgb = image.convertToFormat(QImage::Format_RGB32);
+    std::vector<uint8_t> indices(static_cast<size_t>(rgb.width()) * rgb.height());
+    uint8_t* out = indices.data();
+    for (int y = 0; y < rgb.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(rgb.constScanLine(y));
+        for (int x = 0; x < rgb.width(); ++x) {
+            QRgb c = line[x];
+            *out++ = lut[((qRed(c) >> 3) << 10) | ((qGreen(c) >> 3) << 5) | (qBlue(c) >> 3)];
+        }
+    }
+    return indices;
+}
+
+} // namespace
+
+FrameExporter::FrameExporter(const Options& options)
+    : opts(options) {
+}
+
+bool FrameExporter::fail(const QString& message) {
+    error = message;
+    qDebug() << "FrameExporter:" << message;
+    return false;
+}
+
+bool FrameExporter::exportFrames(const std::vector<AnimationFrame>& frames) {
+    return run(static_cast<int>(frames.size()), [&frames](QString&) -> std::unique_ptr<FrameSource> {
+        return std::make_unique<FrameSource>(&frames);
+    });
+}
+
+bool FrameExporter::exportTimeline(const QString& path) {
+    cancelledByCaller = false;
+    TimelineReader probe;
+    if (!probe.open(path)) return fail(QString("Cannot open timeline %1: %2").arg(path, probe.errorString()));
+    const int frameCount = probe.frameCount();
+    probe.close();
+
+    return run(frameCount, [path](QString& message) -> std::unique_ptr<FrameSource> {
+        auto source = std::make_unique<FrameSource>();
+        if (!source->open(path)) {
+            message = QString("Cannot open timeline %1: %2").arg(path, source->errorString());
+            return nullptr;
+        }
+        return source;
+    });
+}
+
+bool FrameExporter::run(int frameCount, const SourceFactory& openSource) {
+    error.clear();
+    cancelledByCaller = false;
+    if (opts.output.isEmpty()) return fail("No output path given");
+
+    const int first = std::max(0, opts.first);
+    const int last = opts.last < 0 ? frameCount - 1 : std::min(opts.last, frameCount - 1);
+    if (first > last) return fail(QString("Frame range %1..%2 is empty").arg(opts.first).arg(opts.last));
+    const int total = last - first + 1;
+
+    const bool gif = opts.format == Format::Gif;
+    const QDir outDir(opts.output);
+    if (!gif && !outDir.mkpath(".")) return fail(QString("Cannot create directory %1").arg(opts.output));
+
+    std::array<uint32_t, 256> palette{};
+    std::vector<uint8_t> lut;
+    if (gif) {
+        palette = gifPalette();
+        lut = gifLookup(palette);
+    }
+    // Encoded GIF frames, written in order once every chunk is done
+    std::vector<std::vector<uint8_t>> gifBlocks(gif ? total : 0);
+
+    std::atomic<int> done{ 0 };
+    std::atomic<bool> cancelled{ false };
+    QMutex errorMutex;
+    QString taskError;
+    auto taskFailed = [&](const QString& message) {
+        QMutexLocker lock(&errorMutex);
+        if (taskError.isEmpty()) taskError = message;
+        cancelled = true;
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(opts.threads > 0 ? opts.threads : QThread::idealThreadCount());
+    const int chunk = std::max(1, opts.chunkSize);
+
+    for (int start = first; start <= last; start += chunk) {
+        const int end = std::min(last, start + chunk - 1);
+        pool.start(new ExportTask([&, start, end]() {
+            QString message;
+            std::unique_ptr<FrameSource> source = openSource(message);
+            if (!source) {
+                taskFailed(message);
+                return;
+            }
+            OffscreenRenderer renderer(opts.render);
+
+            for (int index = start; index <= end && !cancelled; ++index) {
+                AnimationFrame frame = source->frameAt(index);
+                QImage image = renderer.render(frame);
+
+                if (gif) {
+                    std::vector<uint8_t> indices = quantize(image, lut);
+                    gifBlocks[index - first] = GifEncoder::frame(indices.data(), image.width(), image.height(), frame.duration / 10);
+                } else {
+                    QString name = QString("%1_%2.png").arg(opts.prefix).arg(index, 5, 10, QChar('0'));
+                    if (!image.save(outDir.filePath(name), "PNG")) {
+                        taskFailed(QString("Cannot write %1").arg(outDir.filePath(name)));
+                        return;
+                    }
+                }
+                ++done;
+            }
+        }));
+    }
+
+    // Progress is reported from this thread so the callback may touch the UI
+    while (!pool.waitForDone(PROGRESS_POLL_MS)) {
+        if (progress && !progress(done, total)) cancelled = true;
+    }
+    if (!taskError.isEmpty()) return fail(taskError);
+    if (cancelled) {
+        cancelledByCaller = true;
+        return fail("Export cancelled");
+    }
+    if (progress) progress(total, total);
+    if (!gif) return true;
+
+    QSaveFile file(opts.output);
+    if (!file.open(QIODevice::WriteOnly)) return fail(QString("Cannot write %1").arg(opts.output));
+    const QSize size = opts.render.size.expandedTo(QSize(1, 1));
+    std::vector<uint8_t> header = GifEncoder::header(size.width(), size.height(), palette);
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<qint64>(header.size()));
+    for (const auto& block : gifBlocks) file.write(reinterpret_cast<const char*>(block.data()), static_cast<qint64>(block.size()));
+    const char trailer = static_cast<char>(GifEncoder::TRAILER);
+    file.write(&trailer, 1);
+    if (!file.commit()) return fail(QString("Cannot write %1").arg(opts.output));
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "animation_frame.h"
+#include "offscreen_renderer.h"
+
+/**
+ * @class FrameExporter
+ * @brief Renders a range of frames to a PNG sequence or an animated GIF.
+ *
+ * The range is split into chunks of consecutive frames that run on a
+ * QThreadPool, each with its own OffscreenRenderer (and, for recorded
+ * timelines, its own TimelineReader so deltas decode sequentially).
+ * PNGs are written by the workers directly; GIF frames are quantized and
+ * compressed in parallel, then written in order. The calling thread blocks
+ * until the export finishes, reporting progress through the callback.
+ */
+class FrameExporter {
+public:
+    enum class Format { PngSequence, Gif };
+
+    struct Options {
+        Format format{ Format::PngSequence };
+        QString output;             // directory for PNGs, file path for a GIF
+        QString prefix{ "frame" };  // PNG names are <prefix>_00000.png
+        int first{ 0 };
+        int last{ -1 };             // inclusive, -1 for the last frame
+        int threads{ 0 };           // 0 uses QThread::idealThreadCount()
+        int chunkSize{ 16 };
+        OffscreenRenderer::Options render;
+    };
+
+    // Called on the exporting thread; return false to cancel
+    using ProgressCallback = std::function<bool(int done, int total)>;
+
+    explicit FrameExporter(const Options& options);
+
+    void setProgressCallback(ProgressCallback callback) { progress = std::move(callback); }
+
+    bool exportFrames(const std::vector<AnimationFrame>& frames);
+    bool exportTimeline(const QString& path);
+
+    QString errorString() const { return error; }
+    // True when the last export stopped because the progress callback said so
+    bool wasCancelled() const { return cancelledByCaller; }
+
+private:
+    class FrameSource;
+    using SourceFactory = std::function<std::unique_ptr<FrameSource>(QString& error)>;
+
+    bool run(int frameCount, const SourceFactory& openSource);
+    bool fail(const QString& message);
+
+    Options opts;
+    ProgressCallback progress;
+    QString error;
+    bool cancelledByCaller{ false };
+};
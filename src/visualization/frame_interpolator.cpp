@@ -0,0 +1,137 @@
+#include "frame_interpolator.h"
+#include "render_list.h"
+#include <QColor>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+
+constexpr int LUT_SIZE = 256;
+using EasingTable = std::array<float, LUT_SIZE + 1>;
+
+double easeValue(FrameInterpolator::Easing easing, double t) {
+    switch (easing) {
+    case FrameInterpolator::Easing::Linear:
+        return t;
+    case FrameInterpolator::Easing::EaseOut:
+        return 1.0 - std::pow(1.0 - t, 3);
+    case FrameInterpolator::Easing::EaseInOut:
+    default:
+        return t < 0.5 ? 4.0 * t * t * t : 1.0 - std::pow(-2.0 * t + 2.0, 3) / 2.0;
+    }
+}
+
+// Sampled once per curve on first use
+const EasingTable& easingTable(FrameInterpolator::Easing easing) {
+    static const std::array<EasingTable, 3> tables = [] {
+        std::array<EasingTable, 3> result{};
+        for (int curve = 0; curve < 3; ++curve) {
+            for (int i = 0; i <= LUT_SIZE; ++i) {
+                double t = static_cast<double>(i) / LUT_SIZE;
+                result[curve][i] = static_cast<float>(easeValue(static_cast<FrameInterpolator::Easing>(curve), t));
+            }
+        }
+        return result;
+    }();
+    return tables[static_cast<int>(easing)];
+}
+
+// Resolve a frame color string the way the renderer does
+QColor resolveColor(const std::string* name) {
+    return name ? RenderList::resolveColor(*name) : RenderList::defaultFill();
+}
+
+const std::string* findColor(const AnimationFrame& frame, const std::string& id) {
+    auto it = frame.nodeColors.find(id);
+    return it != frame.nodeColors.end() ? &it->second : nullptr;
+}
+
+} // namespace
+
+double FrameInterpolator::ease(double t) const {
+    t = std::clamp(t, 0.0, 1.0);
+    const EasingTable& table = easingTable(easing);
+    double pos = t * LUT_SIZE;
+    int i = std::min(static_cast<int>(pos), LUT_SIZE - 1);
+    double frac = pos - i;
+    return table[i] + (table[i + 1] - table[i]) * frac;
+}
+
+void FrameInterpolator::clear() {
+    positionTracks.clear();
+    colorTracks.clear();
+    changedIds.clear();
+}
+
+void FrameInterpolator::prepare(const AnimationFrame& from, const AnimationFrame& to) {
+    clear();
+
+    // Nodes that exist in both frames and moved. New nodes just appear.
+    for (const auto& [id, target] : to.nodePositions) {
+        auto it = from.nodePositions.find(id);
+        if (it == from.nodePositions.end() || it->second == target) continue;
+        positionTracks.push_back({ id, it->second.first, it->second.second, target.first, target.second });
+    }
+
+    // Colors: union of both maps, only where the resolved color changes
+    auto addColorTrack = [this, &from, &to](const std::string& id) {
+        const std::string* before = findColor(from, id);
+        const std::string* after = findColor(to, id);
+        QColor a = resolveColor(before);
+        QColor b = resolveColor(after);
+        if (a == b) return;
+        colorTracks.push_back({ id, { a.red(), a.green(), a.blue() }, { b.red(), b.green(), b.blue() },
+            after ? *after : std::string() });
+    };
+    for (const auto& kv : to.nodeColors) addColorTrack(kv.first);
+    for (const auto& kv : from.nodeColors) {
+        if (!to.nodeColors.count(kv.first)) addColorTrack(kv.first);
+    }
+
+    for (const auto& track : positionTracks) changedIds.push_back(track.id);
+    for (const auto& track : colorTracks) changedIds.push_back(track.id);
+    std::sort(changedIds.begin(), changedIds.end());
+    changedIds.erase(std::unique(changedIds.begin(), changedIds.end()), changedIds.end());
+}
+
+void FrameInterpolator::apply(AnimationFrame& frame, double t) const {
+    if (t >= 1.0) {
+        for (const auto& track : positionTracks) {
+            frame.nodePositions[track.id] = { track.toX, track.toY };
+        }
+        for (const auto& track : colorTracks) {
+            if (track.target.empty()) frame.nodeColors.erase(track.id);
+            else frame.nodeColors[track.id] = track.target;
+        }
+        return;
+    }
+
+    double k = ease(t);
+    for (const auto& track : positionTracks) {
+        frame.nodePositions[track.id] = {
+            track.fromX + (track.toX - track.fromX) * k,
+            track.fromY + (track.toY - track.fromY) * k };
+    }
+    for (const auto& track : colorTracks) {
+        int rgb[3];
+        for (int c = 0; c < 3; ++c) {
+            rgb[c] = static_cast<int>(std::lround(track.from[c] + (track.to[c] - track.from[c]) * k));
+        }
+        frame.nodeColors[track.id] = QColor(rgb[0], rgb[1], rgb[2]).name().toStdString();
+    }
+}
+
+AnimationFrame FrameInterpolator::interpolate(const AnimationFrame& from,
+    const AnimationFrame& to,
+    double t) const {
+    if (t <= 0.0) return from;
+
+    FrameInterpolator tween;
+    tween.setEasing(easing);
+    tween.prepare(from, to);
+
+    AnimationFrame frame = to;
+    tween.apply(frame, t);
+    return frame;
+}
@@ -1,17 +1,59 @@
 #pragma once
 
+#include <string>
+#include <vector>
 #include "animation_frame.h"
 
-// FrameInterpolator is responsible for producing intermediate frames
-// between two AnimationFrame states. The default implementation is a
-// no-op that returns the 'from' frame; a richer implementation can
-// interpolate positions/colors over parameter t in [0,1].
+// FrameInterpolator produces intermediate states between two AnimationFrames.
+// Node positions and node colors are tweened; everything else (labels,
+// highlights, edges, annotations) switches to the target frame immediately.
+//
+// prepare() diffs the two frames once and keeps a track per node whose
+// position or color actually changes; apply() then only touches those
+// nodes, so the per-tick cost is proportional to what moves, not to the
+// size of the frame. Easing curves are sampled into lookup tables once.
 class FrameInterpolator {
 public:
+    enum class Easing { Linear, EaseInOut, EaseOut };
+
+    void setEasing(Easing e) { easing = e; }
+    Easing getEasing() const { return easing; }
+
+    // Eased progress for t in [0,1], read from the precomputed table
+    double ease(double t) const;
+
+    // Diff 'from' against 'to' and record the nodes that need tweening
+    void prepare(const AnimationFrame& from, const AnimationFrame& to);
+    // Write the tweened values for progress t into 'frame'. Only tracked
+    // nodes are touched; at t >= 1 they hold exactly the target values.
+    void apply(AnimationFrame& frame, double t) const;
+    void clear();
+
+    bool hasChanges() const { return !positionTracks.empty() || !colorTracks.empty(); }
+    size_t changedNodeCount() const { return changedIds.size(); }
+    // Ids of every node touched by apply()
+    const std::vector<std::string>& changedNodeIds() const { return changedIds; }
+
+    // One-shot helper: the full frame at progress t
     AnimationFrame interpolate(const AnimationFrame& from,
         const AnimationFrame& to,
-        double t) const {
-        (void)t;
-        return from;
-    }
+        double t) const;
+
+private:
+    struct PositionTrack {
+        std::string id;
+        double fromX, fromY;
+        double toX, toY;
+    };
+    struct ColorTrack {
+        std::string id;
+        int from[3];
+        int to[3];
+        std::string target; // exact target string, empty when the target has none
+    };
+
+    Easing easing{ Easing::EaseInOut };
+    std::vector<PositionTrack> positionTracks;
+    std::vector<ColorTrack> colorTracks;
+    std::vector<std::string> changedIds;
 };
@@ -0,0 +1,447 @@
+#include "frame_painter.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+
+// Device-pixel bucket of a point, packed into one key
+long long bucketKey(const QPointF& pt, double cell) {
+    long long x = static_cast<long long>(std::floor(pt.x() / cell));
+    long long y = static_cast<long long>(std::floor(pt.y() / cell));
+    return static_cast<long long>((static_cast<unsigned long long>(x) << 32) | (static_cast<unsigned long long>(y) & 0xffffffffULL));
+}
+
+QPointF bucketCenter(long long key, double cell) {
+    double x = static_cast<double>(key >> 32);
+    double y = static_cast<double>(static_cast<int>(static_cast<unsigned int>(key & 0xffffffffLL)));
+    return QPointF((x + 0.5) * cell, (y + 0.5) * cell);
+}
+
+struct SegmentHash {
+    size_t operator()(const std::pair<long long, long long>& s) const {
+        // Mix in uint64_t: wrap-around is defined there, unlike signed overflow
+        const uint64_t mixed = static_cast<uint64_t>(s.first) * 31 + static_cast<uint64_t>(s.second);
+        return std::hash<uint64_t>()(mixed);
+    }
+};
+
+// Full detail strokes 2 px scene pens; lower tiers use hairlines
+QPen strokePen(const QColor& color, bool full) {
+    QPen pen(color, full ? 2 : 1);
+    pen.setCosmetic(!full);
+    return pen;
+}
+
+} // namespace
+
+FramePainter::FramePainter(const RenderList& list, int nodeRadius)
+    : renderList(list), nodeRadius(nodeRadius) {
+}
+
+FramePainter::DetailLevel FramePainter::detailLevelFor(double nodePixels) {
+    if (nodePixels >= LABEL_MIN_PX) return DetailLevel::Full;
+    if (nodePixels >= SHAPE_MIN_PX) return DetailLevel::Shapes;
+    if (nodePixels >= POINT_MIN_PX) return DetailLevel::Points;
+    return DetailLevel::Clusters;
+}
+
+QTransform FramePainter::camera(const QSizeF& size, double zoom, const QPointF& pan) {
+    QTransform camera;
+    camera.translate(size.width() / 2.0, size.height() / 2.0);
+    camera.scale(zoom, zoom);
+    camera.translate(-size.width() / 2.0 + pan.x(), -size.height() / 2.0 + pan.y());
+    return camera;
+}
+
+void FramePainter::paintGrid(QPainter& p, const QRectF& viewport) const {
+    // A subtle grid to help positioning, over the visible area only
+    QPen gridPen(QColor("#F0F0F0"), 1, Qt::SolidLine);
+    gridPen.setCosmetic(true);
+    p.setPen(gridPen);
+
+    const double gridSize = 50;
+    double startX = std::floor(viewport.left() / gridSize) * gridSize;
+    double startY = std::floor(viewport.top() / gridSize) * gridSize;
+
+    for (double x = startX; x <= viewport.right(); x += gridSize) {
+        p.drawLine(QPointF(x, viewport.top()), QPointF(x, viewport.bottom()));
+    }
+    for (double y = startY; y <= viewport.bottom(); y += gridSize) {
+        p.drawLine(QPointF(viewport.left(), y), QPointF(viewport.right(), y));
+    }
+}
+
+void FramePainter::paintEdges(QPainter& p, const QRectF& viewport, bool full) {
+    // Edge geometry was resolved when the frame was compiled. All lines go
+    // out in one drawLines call and all arrowheads in one filled path.
+    const auto& edges = renderList.edges();
+    renderList.edgesIn(viewport, visibleEdges);
+    lineBatch.clear();
+    QPainterPath arrows;
+    arrows.setFillRule(Qt::WindingFill);
+    for (int e : visibleEdges) {
+        const RenderEdge& edge = edges[e];
+        lineBatch.emplace_back(edge.from, edge.to);
+        if (edge.arrow) {
+            arrows.moveTo(edge.arrowHead[0]);
+            arrows.lineTo(edge.arrowHead[1]);
+            arrows.lineTo(edge.arrowHead[2]);
+            arrows.closeSubpath();
+        }
+    }
+
+    p.setRenderHint(QPainter::Antialiasing, full);
+    p.setPen(strokePen(Qt::black, full));
+    p.drawLines(lineBatch.data(), static_cast<int>(lineBatch.size()));
+    if (!arrows.isEmpty()) {
+        p.setBrush(Qt::black);
+        p.drawPath(arrows);
+    }
+}
+
+void FramePainter::paintNodes(QPainter& p, const QRectF& area, bool full) {
+    renderList.nodesIn(area, visibleNodes);
+    if (full && paintNodeSprites(p)) {
+        paintIndexLabels(p, visibleNodes);
+        return;
+    }
+
+    const auto& nodes = renderList.nodes();
+    const double r = nodeRadius;
+    const QPen cellPen = strokePen(QColor("#2C3E50"), full);
+    const QPen outlinePen = strokePen(Qt::black, full);
+
+    // Below full detail: no labels, no antialiasing, hairline pens
+    p.setRenderHint(QPainter::Antialiasing, full);
+
+    // Order visible nodes by (shape, fill) so every run shares pen and brush;
+    // the stable sort keeps the scene order inside a run. Nodes that overlap
+    // another one are left out and drawn afterwards in scene order, so the
+    // upper node still hides the lower one's fill and label.
+    batchOrder.clear();
+    for (int slot : visibleNodes) {
+        if (!nodes[slot].overlapped) batchOrder.push_back(slot);
+    }
+    std::stable_sort(batchOrder.begin(), batchOrder.end(), [&nodes](int a, int b) {
+        const RenderNode& x = nodes[a];
+        const RenderNode& y = nodes[b];
+        if (x.shape != y.shape) return x.shape < y.shape;
+        return x.fill.rgba() < y.fill.rgba();
+    });
+
+    // One drawRects / drawPath per run, one drawLines for every list pointer bar
+    lineBatch.clear();
+    size_t i = 0;
+    while (i < batchOrder.size()) {
+        const RenderNode& first = nodes[batchOrder[i]];
+        rectBatch.clear();
+        // Winding fill: overlapping nodes must not punch holes into each other
+        QPainterPath circles;
+        circles.setFillRule(Qt::WindingFill);
+        size_t end = i;
+        for (; end < batchOrder.size(); ++end) {
+            const RenderNode& node = nodes[batchOrder[end]];
+            if (node.shape != first.shape || node.fill.rgba() != first.fill.rgba()) break;
+            if (node.shape == NodeShape::Circle) {
+                circles.addEllipse(node.center, r, r);
+                continue;
+            }
+            rectBatch.push_back(node.bounds);
+            if (node.shape == NodeShape::Rect) {
+                // List node style: rectangular with a small pointer section
+                double barX = node.center.x() + node.bounds.width() / 6;
+                lineBatch.emplace_back(QPointF(barX, node.bounds.top()), QPointF(barX, node.bounds.bottom()));
+            }
+        }
+
+        p.setBrush(first.fill);
+        p.setPen(first.shape == NodeShape::ArrayCell ? cellPen : outlinePen);
+        if (first.shape == NodeShape::Circle) p.drawPath(circles);
+        else p.drawRects(rectBatch.data(), static_cast<int>(rectBatch.size()));
+        i = end;
+    }
+    if (!lineBatch.empty()) {
+        p.setPen(outlinePen);
+        p.drawLines(lineBatch.data(), static_cast<int>(lineBatch.size()));
+    }
+    if (full) paintBatchLabels(p);
+
+    // Overlapping nodes touch nothing batched above, only each other
+    std::vector<int> stacked;
+    for (int slot : visibleNodes) {
+        if (!nodes[slot].overlapped) continue;
+        drawNode(p, nodes[slot], slot, full);
+        stacked.push_back(slot);
+    }
+    if (full && !stacked.empty()) paintIndexLabels(p, stacked);
+}
+
+void FramePainter::paintBatchLabels(QPainter& p) const {
+    const auto& nodes = renderList.nodes();
+
+    // Labels, one pass per font and pen. Array values and indices are
+    // pre-laid-out glyphs positioned at compile time.
+    const QFont baseFont = p.font();
+    p.setPen(Qt::black);
+    p.setFont(renderList.valueFont());
+    for (int slot : batchOrder) {
+        const RenderNode& node = nodes[slot];
+        if (node.shape == NodeShape::ArrayCell) drawGlyph(p, node.valuePos, renderList.valueGlyph(node.valueGlyph));
+    }
+
+    paintIndexLabels(p, batchOrder);
+    p.setPen(Qt::white);
+    p.setFont(baseFont);
+    for (int slot : batchOrder) {
+        const RenderNode& node = nodes[slot];
+        if (node.shape != NodeShape::ArrayCell) p.drawText(node.textRect, Qt::AlignCenter, renderList.label(slot));
+    }
+}
+
+void FramePainter::drawGlyph(QPainter& p, const QPointF& topLeft, const QStaticText& glyph) const {
+    if (staticText) {
+        p.drawStaticText(topLeft, glyph);
+        return;
+    }
+    // Same placement as the glyph, without touching its shared layout cache
+    p.drawText(QRectF(topLeft, QSizeF(GLYPH_BOX, GLYPH_BOX)), Qt::AlignLeft | Qt::AlignTop | Qt::TextSingleLine, glyph.text());
+}
+
+void FramePainter::paintIndexLabels(QPainter& p, const std::vector<int>& order) const {
+    // Index in red below each memory cell
+    const auto& nodes = renderList.nodes();
+    const QFont baseFont = p.font();
+    p.setPen(QColor("#E74C3C"));
+    p.setFont(renderList.indexFont());
+    for (int slot : order) {
+        const RenderNode& node = nodes[slot];
+        if (node.shape == NodeShape::ArrayCell && node.indexSlot >= 0) {
+            drawGlyph(p, node.indexPos, renderList.indexGlyph(node.indexSlot));
+        }
+    }
+    p.setFont(baseFont);
+}
+
+void FramePainter::drawNode(QPainter& p, const RenderNode& node, int slot, bool full) const {
+    // One node: the same output as the batched passes at that detail
+    const double r = nodeRadius;
+    const QPen outlinePen = strokePen(Qt::black, full);
+    p.setBrush(node.fill);
+    p.setPen(node.shape == NodeShape::ArrayCell ? strokePen(QColor("#2C3E50"), full) : outlinePen);
+    switch (node.shape) {
+    case NodeShape::Circle:
+        p.drawEllipse(node.center, r, r);
+        break;
+    case NodeShape::Rect: {
+        p.drawRect(node.bounds);
+        double barX = node.center.x() + node.bounds.width() / 6;
+        p.drawLine(QPointF(barX, node.bounds.top()), QPointF(barX, node.bounds.bottom()));
+        break;
+    }
+    case NodeShape::ArrayCell:
+        p.drawRect(node.bounds);
+        break;
+    }
+    if (!full) return;
+
+    if (node.shape == NodeShape::ArrayCell) {
+        if (node.valueGlyph < 0) return;
+        const QFont baseFont = p.font();
+        p.setPen(Qt::black);
+        p.setFont(renderList.valueFont());
+        drawGlyph(p, node.valuePos, renderList.valueGlyph(node.valueGlyph));
+        p.setFont(baseFont);
+    } else {
+        p.setPen(Qt::white);
+        p.drawText(node.textRect, Qt::AlignCenter, renderList.label(slot));
+    }
+}
+
+bool FramePainter::paintNodeSprites(QPainter& p) {
+    // Sprites are blitted pixel-for-pixel, so only scale + translate cameras qualify
+    const QTransform toDevice = p.transform();
+    if (toDevice.type() > QTransform::TxScale || toDevice.m11() != toDevice.m22()) return false;
+    const double ratio = p.device()->devicePixelRatioF();
+    const double scale = toDevice.m11() * ratio;
+    sprites.configure(scale, nodeRadius, p.font());
+    sprites.beginPaint();
+
+    const auto& nodes = renderList.nodes();
+    p.save();
+    p.resetTransform();
+    for (int slot : visibleNodes) {
+        const RenderNode& node = nodes[slot];
+        const QRectF outer = node.bounds.adjusted(-SPRITE_MARGIN, -SPRITE_MARGIN, SPRITE_MARGIN, SPRITE_MARGIN);
+        const QSize size(static_cast<int>(std::ceil(outer.width() * scale)), static_cast<int>(std::ceil(outer.height() * scale)));
+
+        SpriteAtlas::Key key{ static_cast<unsigned char>(node.shape), node.fill.rgba(),
+            node.shape == NodeShape::ArrayCell ? (node.valueGlyph >= 0 ? renderList.valueGlyph(node.valueGlyph).text() : QString())
+                                               : renderList.label(slot),
+            size };
+        SpriteAtlas::Sprite sprite;
+        bool cached = size.width() <= MAX_SPRITE_PX && size.height() <= MAX_SPRITE_PX && sprites.find(key, sprite);
+        if (!cached && size.width() <= MAX_SPRITE_PX && size.height() <= MAX_SPRITE_PX && sprites.allocate(key, sprite)) {
+            // First use: rasterize the node into its slot, scene-aligned to the slot corner
+            QPainter sp(sprite.page);
+            sp.setRenderHint(QPainter::Antialiasing);
+            sp.setFont(p.font());
+            // Wide values (long or negative numbers) must not spill into neighbouring slots
+            sp.setClipRect(sprite.source);
+            sp.translate(sprite.source.topLeft());
+            sp.scale(scale, scale);
+            sp.translate(-outer.topLeft());
+            drawNode(sp, node, slot);
+            cached = true;
+        }
+
+        if (!cached) {
+            // Too large, or the atlas is saturated by this paint: draw it directly
+            p.setTransform(toDevice);
+            p.setRenderHint(QPainter::Antialiasing);
+            drawNode(p, node, slot);
+            p.resetTransform();
+            continue;
+        }
+
+        // Snap to whole device pixels so the blit stays a plain copy
+        const QPointF origin = toDevice.map(outer.topLeft()) * ratio;
+        const QRectF target(QPointF(std::round(origin.x()), std::round(origin.y())) / ratio, QSizeF(size) / ratio);
+        p.drawImage(target, *sprite.page, QRectF(sprite.source));
+    }
+    p.restore();
+    return true;
+}
+
+void FramePainter::paintHighlights(QPainter& p, const QRectF& area) const {
+    // Outer glow/outline for highlighted nodes, as one path
+    const double r = nodeRadius;
+    QPainterPath halos;
+    const auto& nodes = renderList.nodes();
+    for (int slot : renderList.highlights()) {
+        const RenderNode& node = nodes[slot];
+        if (!node.bounds.adjusted(-8, -8, 8, 8).intersects(area)) continue;
+        switch (node.shape) {
+        case NodeShape::ArrayCell:
+            halos.addRect(node.bounds.adjusted(-2, -2, 2, 2));
+            break;
+        case NodeShape::Rect: {
+            double w = r * 3.0 + 10;
+            double h = r * 1.5 + 10;
+            halos.addRect(QRectF(node.center.x() - w / 2, node.center.y() - h / 2, w, h));
+            break;
+        }
+        case NodeShape::Circle:
+            halos.addEllipse(node.center, r + 5, r + 5);
+            break;
+        }
+    }
+    if (halos.isEmpty()) return;
+    p.setPen(QPen(QColor(255, 215, 0), 3)); // gold outline
+    p.setBrush(Qt::NoBrush);
+    p.drawPath(halos);
+}
+
+void FramePainter::paintDense(QPainter& p, const QRectF& viewport, DetailLevel level, const QRect& deviceRect) {
+    // Draw in device pixels: everything that lands in the same bucket is drawn once
+    const QTransform toDevice = p.transform();
+    const double cell = level == DetailLevel::Clusters ? CLUSTER_CELL_PX : DENSITY_CELL_PX;
+    const auto& nodes = renderList.nodes();
+    const auto& edges = renderList.edges();
+    renderList.nodesIn(viewport, visibleNodes);
+    renderList.edgesIn(viewport, visibleEdges);
+
+    p.save();
+    p.resetTransform();
+    p.setRenderHint(QPainter::Antialiasing, false);
+
+    // Parallel edges collapse into one segment per bucket pair; the count
+    // picks one of a few darkness levels so each level is a single drawLines
+    std::unordered_map<std::pair<long long, long long>, int, SegmentHash> segments;
+    segments.reserve(visibleEdges.size());
+    for (int e : visibleEdges) {
+        long long a = bucketKey(toDevice.map(edges[e].from), cell);
+        long long b = bucketKey(toDevice.map(edges[e].to), cell);
+        if (a == b) continue;
+        if (b < a) std::swap(a, b);
+        ++segments[{ a, b }];
+    }
+
+    constexpr int DENSITY_LEVELS = 4;
+    std::vector<QLineF> lines[DENSITY_LEVELS];
+    for (const auto& [segment, count] : segments) {
+        int shade = std::min(DENSITY_LEVELS - 1, static_cast<int>(std::log2(count)));
+        lines[shade].emplace_back(bucketCenter(segment.first, cell), bucketCenter(segment.second, cell));
+    }
+    for (int shade = 0; shade < DENSITY_LEVELS; ++shade) {
+        if (lines[shade].empty()) continue;
+        p.setPen(QPen(QColor(0, 0, 0, 70 + shade * 60), 1));
+        p.drawLines(lines[shade].data(), static_cast<int>(lines[shade].size()));
+    }
+
+    if (level == DetailLevel::Points) {
+        // One point per occupied bucket, batched by fill color
+        std::unordered_map<long long, int> occupied;
+        std::unordered_map<QRgb, std::vector<QPointF>> byColor;
+        for (int slot : visibleNodes) {
+            QPointF pt = toDevice.map(nodes[slot].center);
+            if (!occupied.emplace(bucketKey(pt, cell), slot).second) continue;
+            byColor[nodes[slot].fill.rgb()].push_back(pt);
+        }
+        for (const auto& [rgb, points] : byColor) {
+            p.setPen(QPen(QColor::fromRgba(rgb), POINT_SIZE_PX, Qt::SolidLine, Qt::RoundCap));
+            p.drawPoints(points.data(), static_cast<int>(points.size()));
+        }
+    } else {
+        // Clusters: one disc per bucket at the mean position, sized by population
+        struct Cluster {
+            double x, y;
+            int count;
+            QColor fill;
+        };
+        std::unordered_map<long long, Cluster> clusters;
+        for (int slot : visibleNodes) {
+            QPointF pt = toDevice.map(nodes[slot].center);
+            auto [it, added] = clusters.try_emplace(bucketKey(pt, cell), Cluster{ 0, 0, 0, nodes[slot].fill });
+            it->second.x += pt.x();
+            it->second.y += pt.y();
+            ++it->second.count;
+        }
+        p.setPen(Qt::NoPen);
+        for (const auto& [key, c] : clusters) {
+            double radius = std::min(cell / 2 + 1, 1.5 + std::sqrt(static_cast<double>(c.count)));
+            p.setBrush(c.fill);
+            p.drawEllipse(QPointF(c.x / c.count, c.y / c.count), radius, radius);
+        }
+    }
+
+    // Highlights stay visible as fixed-size rings
+    p.setPen(QPen(QColor(255, 215, 0), 2));
+    p.setBrush(Qt::NoBrush);
+    QRectF screen(deviceRect);
+    for (int slot : renderList.highlights()) {
+        QPointF pt = toDevice.map(nodes[slot].center);
+        if (screen.contains(pt)) p.drawEllipse(pt, HIGHLIGHT_RING_PX, HIGHLIGHT_RING_PX);
+    }
+    p.restore();
+}
+
+void FramePainter::paintScene(QPainter& p, const QTransform& camera, const QRect& deviceRect, double zoom) {
+    const QRectF viewport = camera.inverted().mapRect(QRectF(deviceRect));
+    const DetailLevel level = detailLevelFor(2.0 * nodeRadius * zoom);
+    const bool full = level == DetailLevel::Full;
+
+    p.fillRect(deviceRect, Qt::white);
+    p.setTransform(camera);
+    paintGrid(p, viewport);
+    if (isDense(level)) {
+        paintDense(p, viewport, level, deviceRect);
+        return;
+    }
+    paintEdges(p, viewport, full);
+    paintNodes(p, viewport, full);
+    paintHighlights(p, viewport);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QLineF>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QSizeF>
+#include <QTransform>
+#include <vector>
+#include "render_list.h"
+#include "sprite_atlas.h"
+
+class QPainter;
+
+/**
+ * @class FramePainter
+ * @brief Draws a compiled RenderList onto any QPainter.
+ *
+ * Holds the visual rules of the canvas: the grid, edge and node styles,
+ * labels, highlight halos and the level-of-detail tiers. The live widget
+ * and the headless exporter both go through it, so they produce the same
+ * picture. It only reads the RenderList, but its scratch buffers and
+ * sprite atlas are reused between calls, so each thread needs its own
+ * instance.
+ *
+ * At full detail each distinct (shape, fill, label) is rasterized once
+ * into a SpriteAtlas and then blitted, so a repaint of a large array is
+ * mostly image copies instead of antialiased shapes and text layout.
+ */
+class FramePainter {
+public:
+    // Level of detail, chosen from the projected node diameter in pixels:
+    // Full draws everything, Shapes drops labels and antialiasing, Points
+    // draws nodes as dots and collapses parallel edges, Clusters merges
+    // nearby nodes into one disc.
+    enum class DetailLevel { Full, Shapes, Points, Clusters };
+    static DetailLevel detailLevelFor(double nodePixels);
+    static bool isDense(DetailLevel level) { return level == DetailLevel::Points || level == DetailLevel::Clusters; }
+
+    // Scene -> device transform: center the scene, apply zoom, then pan offset
+    static QTransform camera(const QSizeF& size, double zoom, const QPointF& pan);
+
+    FramePainter(const RenderList& list, int nodeRadius);
+    void setNodeRadius(int radius) { nodeRadius = radius; }
+    // QStaticText re-lays itself out when drawn under a new transform, which
+    // is not safe while other threads draw the same RenderList glyphs.
+    // Painters that share a RenderList across threads turn it off.
+    void setStaticText(bool enabled) { staticText = enabled; }
+
+    // Scene-space passes; 'p' must already carry the camera transform
+    void paintGrid(QPainter& p, const QRectF& viewport) const;
+    void paintEdges(QPainter& p, const QRectF& viewport, bool full);
+    void paintNodes(QPainter& p, const QRectF& area, bool full);
+    void paintHighlights(QPainter& p, const QRectF& area) const;
+    // Points/Clusters tiers: edges, nodes and highlights in device pixels
+    void paintDense(QPainter& p, const QRectF& viewport, DetailLevel level, const QRect& deviceRect);
+
+    // All passes in order on a white background, without any caching
+    void paintScene(QPainter& p, const QTransform& camera, const QRect& deviceRect, double zoom);
+
+private:
+    static constexpr double LABEL_MIN_PX = 12.0;
+    static constexpr double SHAPE_MIN_PX = 4.0;
+    static constexpr double POINT_MIN_PX = 1.5;
+    static constexpr double DENSITY_CELL_PX = 3.0;
+    static constexpr double CLUSTER_CELL_PX = 10.0;
+    static constexpr double POINT_SIZE_PX = 3.0;
+    static constexpr double HIGHLIGHT_RING_PX = 5.0;
+    // Scene units around a node's bounds covered by its sprite (stroke + antialiasing)
+    static constexpr double SPRITE_MARGIN = 2.0;
+    static constexpr int MAX_SPRITE_PX = 256;
+
+    // Full-detail nodes as atlas blits; false when the camera cannot use sprites
+    bool paintNodeSprites(QPainter& p);
+    void drawNode(QPainter& p, const RenderNode& node, int slot, bool full = true) const;
+    void paintIndexLabels(QPainter& p, const std::vector<int>& order) const;
+    // Values, indices and labels of the batched (non-overlapping) nodes
+    void paintBatchLabels(QPainter& p) const;
+    void drawGlyph(QPainter& p, const QPointF& topLeft, const QStaticText& glyph) const;
+    static constexpr double GLYPH_BOX = 1000.0;
+
+    const RenderList& renderList;
+    int nodeRadius;
+    bool staticText{ true };
+
+    // Culling results and batching scratch space, reused across paints
+    std::vector<int> visibleNodes;
+    std::vector<int> visibleEdges;
+    std::vector<int> batchOrder;
+    std::vector<QRectF> rectBatch;
+    std::vector<QLineF> lineBatch;
+    SpriteAtlas sprites;
+};
@@ -0,0 +1,172 @@
+#include "gif_encoder.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int MIN_CODE_SIZE = 8;
+constexpr int CLEAR_CODE = 1 << MIN_CODE_SIZE;
+constexpr int END_CODE = CLEAR_CODE + 1;
+constexpr int MAX_CODE = 4095;
+constexpr size_t TABLE_SIZE = 1 << 14; // open addressing, > 4096 entries
+
+void put16(std::vector<uint8_t>& out, int value) {
+    out.push_back(static_cast<uint8_t>(value & 0xff));
+    out.push_back(static_cast<uint8_t>((value >> 8) & 0xff));
+}
+
+// LSB-first bit packer used by GIF's LZW stream
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    void write(int code, int size) {
+        buffer |= static_cast<uint32_t>(code) << bits;
+        bits += size;
+        while (bits >= 8) {
+            out.push_back(static_cast<uint8_t>(buffer & 0xff));
+            buffer >>= 8;
+            bits -= 8;
+        }
+    }
+
+    void flush() {
+        if (bits > 0) out.push_back(static_cast<uint8_t>(buffer & 0xff));
+        buffer = 0;
+        bits = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out;
+    uint32_t buffer{ 0 };
+    int bits{ 0 };
+};
+
+// (prefix code, next byte) -> code, reset whenever the code space fills up
+class CodeTable {
+public:
+    CodeTable() : keys(TABLE_SIZE), codes(TABLE_SIZE) { reset(); }
+
+    void reset() { std::fill(keys.begin(), keys.end(), -1); }
+
+    int find(int prefix, uint8_t byte) const {
+        int key = (prefix << 8) | byte;
+        for (size_t slot = hash(key);; slot = (slot + 1) & (TABLE_SIZE - 1)) {
+            if (keys[slot] == key) return codes[slot];
+            if (keys[slot] < 0) return -1;
+        }
+    }
+
+    void insert(int prefix, uint8_t byte, int code) {
+        int key = (prefix << 8) | byte;
+        size_t slot = hash(key);
+        while (keys[slot] >= 0) slot = (slot + 1) & (TABLE_SIZE - 1);
+        keys[slot] = key;
+        codes[slot] = static_cast<uint16_t>(code);
+    }
+
+private:
+    static size_t hash(int key) { return (static_cast<uint32_t>(key) * 2654435761u) >> 18; }
+
+    std::vector<int32_t> keys;
+    std::vector<uint16_t> codes;
+};
+
+} // namespace
+
+std::vector<uint8_t> GifEncoder::header(int width, int height, const std::array<uint32_t, 256>& palette) {
+    std::vector<uint8_t> out;
+    out.reserve(13 + 3 * 256 + 19);
+    const char* signature = "GIF89a";
+    out.insert(out.end(), signature, signature + 6);
+
+    // Logical screen descriptor: global table of 2^(7+1) colors, 8 bits per channel
+    put16(out, width);
+    put16(out, height);
+    out.push_back(0xF7);
+    out.push_back(0); // background color index
+    out.push_back(0); // pixel aspect ratio
+
+    for (uint32_t rgb : palette) {
+        out.push_back(static_cast<uint8_t>((rgb >> 16) & 0xff));
+        out.push_back(static_cast<uint8_t>((rgb >> 8) & 0xff));
+        out.push_back(static_cast<uint8_t>(rgb & 0xff));
+    }
+
+    // NETSCAPE2.0 application extension: loop forever
+    const uint8_t loop[] = { 0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0x00, 0x00, 0x00 };
+    out.insert(out.end(), loop, loop + sizeof(loop));
+    return out;
+}
+
+std::vector<uint8_t> GifEncoder::frame(const uint8_t* indices, int width, int height, int delayCentiseconds) {
+    std::vector<uint8_t> out;
+
+    // Graphic control extension: leave the frame in place, no transparency
+    out.push_back(0x21);
+    out.push_back(0xF9);
+    out.push_back(0x04);
+    out.push_back(0x04);
+    put16(out, std::clamp(delayCentiseconds, 2, 0xffff));
+    out.push_back(0x00);
+    out.push_back(0x00);
+
+    // Image descriptor: full screen, global palette, not interlaced
+    out.push_back(0x2C);
+    put16(out, 0);
+    put16(out, 0);
+    put16(out, width);
+    put16(out, height);
+    out.push_back(0x00);
+
+    std::vector<uint8_t> lzw;
+    lzwEncode(indices, static_cast<size_t>(width) * height, lzw);
+
+    // Image data: code size, then the LZW stream in sub-blocks of up to 255 bytes
+    out.push_back(MIN_CODE_SIZE);
+    for (size_t pos = 0; pos < lzw.size(); pos += 255) {
+        size_t length = std::min<size_t>(255, lzw.size() - pos);
+        out.push_back(static_cast<uint8_t>(length));
+        out.insert(out.end(), lzw.begin() + pos, lzw.begin() + pos + length);
+    }
+    out.push_back(0x00);
+    return out;
+}
+
+void GifEncoder::lzwEncode(const uint8_t* indices, size_t count, std::vector<uint8_t>& out) {
+    BitWriter writer(out);
+    CodeTable table;
+    int codeSize = MIN_CODE_SIZE + 1;
+    int lastCode = END_CODE;
+
+    writer.write(CLEAR_CODE, codeSize);
+    if (count == 0) {
+        writer.write(END_CODE, codeSize);
+        writer.flush();
+        return;
+    }
+
+    int prefix = indices[0];
+    for (size_t i = 1; i < count; ++i) {
+        uint8_t byte = indices[i];
+        int code = table.find(prefix, byte);
+        if (code >= 0) {
+            prefix = code;
+            continue;
+        }
+
+        writer.write(prefix, codeSize);
+        table.insert(prefix, byte, ++lastCode);
+        if (lastCode >= (1 << codeSize)) ++codeSize;
+        if (lastCode == MAX_CODE) {
+            // Code space is full: start over with a fresh table
+            writer.write(CLEAR_CODE, codeSize);
+            table.reset();
+            codeSize = MIN_CODE_SIZE + 1;
+            lastCode = END_CODE;
+        }
+        prefix = byte;
+    }
+    writer.write(prefix, codeSize);
+    writer.write(END_CODE, codeSize);
+    writer.flush();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class GifEncoder
+ * @brief Minimal GIF89a writer for 8-bit indexed frames.
+ *
+ * Qt can read GIFs but not write them, so animated exports are encoded
+ * here. A file is header() + one frame() per image + TRAILER. Frames only
+ * depend on their own pixels, so they can be encoded in parallel and
+ * concatenated in order afterwards.
+ */
+class GifEncoder {
+public:
+    static constexpr uint8_t TRAILER = 0x3B;
+
+    // Logical screen with a 256-entry global palette (0xRRGGBB), looping forever
+    static std::vector<uint8_t> header(int width, int height, const std::array<uint32_t, 256>& palette);
+
+    // One full-screen image: 'indices' holds width*height palette indices
+    static std::vector<uint8_t> frame(const uint8_t* indices, int width, int height, int delayCentiseconds);
+
+private:
+    static void lzwEncode(const uint8_t* indices, size_t count, std::vector<uint8_t>& out);
+};
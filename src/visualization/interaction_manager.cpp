@@ -617,6 +617,15 @@ void InteractionManager::updateNodePosition(const std::string& nodeId, double x,
     }
 }
 
+void InteractionManager::updateNodePositions(const std::map<std::string, std::pair<double, double>>& positions) {
+    for (auto& node : nodes) {
+        auto it = positions.find(node.id);
+        if (it == positions.end()) continue;
+        node.x = it->second.first;
+        node.y = it->second.second;
+    }
+}
+
 void InteractionManager::addEdge(const std::string& sourceId, const std::string& targetId) {
     edges.push_back({ sourceId, targetId });
 
@@ -94,6 +94,12 @@ public:
      */
     void updateNodePosition(const std::string& nodeId, double x, double y);
 
+    /**
+     * @brief Move many nodes in one pass (e.g. a layout step)
+     * @param positions Canvas node ID to new (x, y); unknown IDs are ignored
+     */
+    void updateNodePositions(const std::map<std::string, std::pair<double, double>>& positions);
+
     void addEdge(const std::string& sourceId, const std::string& targetId);
     void removeEdge(const std::string& sourceId, const std::string& targetId);
 
@@ -0,0 +1,168 @@
+#include "label_table.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+// Overrides are folded into a new base once they exceed this many entries,
+// or the square root of the base size, whichever is larger. A rebase costs
+// O(n) and every frame copies the overrides, so sqrt(n) keeps both the
+// amortized rebase and the per-copy cost at O(sqrt n).
+constexpr size_t MIN_REBASE_THRESHOLD = 32;
+
+uint64_t nextVersion() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
+
+const std::shared_ptr<const LabelTable::Map>& emptyBase() {
+    static const std::shared_ptr<const LabelTable::Map> empty = std::make_shared<const LabelTable::Map>();
+    return empty;
+}
+
+} // namespace
+
+LabelTable::LabelTable()
+    : base(emptyBase()), baseVersion(0) {
+}
+
+LabelTable::LabelTable(Map labels)
+    : base(std::make_shared<const Map>(std::move(labels))), baseVersion(nextVersion()) {
+}
+
+void LabelTable::set(const std::string& id, std::string label) {
+    auto it = base->find(id);
+    if (it != base->end() && it->second == label) {
+        // Back to the base value: the override is no longer needed
+        overrides.erase(id);
+        return;
+    }
+    overrides[id] = std::move(label);
+    maybeRebase();
+}
+
+void LabelTable::erase(const std::string& id) {
+    if (base->count(id)) {
+        overrides[id] = std::nullopt;
+        maybeRebase();
+    } else {
+        overrides.erase(id);
+    }
+}
+
+void LabelTable::clear() {
+    base = emptyBase();
+    baseVersion = 0;
+    overrides.clear();
+}
+
+const std::string* LabelTable::find(const std::string& id) const {
+    if (!overrides.empty()) {
+        auto o = overrides.find(id);
+        if (o != overrides.end()) {
+            return o->second ? &*o->second : nullptr;
+        }
+    }
+    auto it = base->find(id);
+    return it != base->end() ? &it->second : nullptr;
+}
+
+const std::string& LabelTable::at(const std::string& id) const {
+    const std::string* label = find(id);
+    if (!label) throw std::out_of_range("LabelTable::at: no label for " + id);
+    return *label;
+}
+
+bool LabelTable::empty() const {
+    return size() == 0;
+}
+
+size_t LabelTable::size() const {
+    size_t n = base->size();
+    for (const auto& [id, label] : overrides) {
+        bool inBase = base->count(id) > 0;
+        if (label && !inBase) ++n;
+        else if (!label && inBase) --n;
+    }
+    return n;
+}
+
+void LabelTable::forEach(const std::function<void(const std::string&, const std::string&)>& fn) const {
+    // Merge the two sorted sequences; overrides win on equal keys
+    auto b = base->begin();
+    auto o = overrides.begin();
+    while (b != base->end() || o != overrides.end()) {
+        if (o == overrides.end() || (b != base->end() && b->first < o->first)) {
+            fn(b->first, b->second);
+            ++b;
+            continue;
+        }
+        if (b != base->end() && b->first == o->first) ++b;
+        if (o->second) fn(o->first, *o->second);
+        ++o;
+    }
+}
+
+LabelTable::Map LabelTable::toMap() const {
+    if (overrides.empty()) return *base;
+    Map merged;
+    forEach([&merged](const std::string& id, const std::string& label) {
+        merged.emplace_hint(merged.end(), id, label);
+    });
+    return merged;
+}
+
+void LabelTable::diff(const LabelTable& other,
+    const std::function<void(const std::string&, const std::string*, const std::string*)>& fn) const {
+    if (base == other.base) {
+        // Only ids overridden on either side can differ
+        std::set<std::string> ids;
+        for (const auto& kv : overrides) ids.insert(kv.first);
+        for (const auto& kv : other.overrides) ids.insert(kv.first);
+        for (const std::string& id : ids) {
+            const std::string* before = find(id);
+            const std::string* after = other.find(id);
+            if (before == after) continue;
+            if (before && after && *before == *after) continue;
+            fn(id, before, after);
+        }
+        return;
+    }
+
+    Map a = toMap();
+    Map b = other.toMap();
+    auto i = a.begin();
+    auto j = b.begin();
+    while (i != a.end() || j != b.end()) {
+        if (j == b.end() || (i != a.end() && i->first < j->first)) {
+            fn(i->first, &i->second, nullptr);
+            ++i;
+        } else if (i == a.end() || j->first < i->first) {
+            fn(j->first, nullptr, &j->second);
+            ++j;
+        } else {
+            if (i->second != j->second) fn(i->first, &i->second, &j->second);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+bool LabelTable::operator==(const LabelTable& other) const {
+    // Same base: only the overrides can differ
+    if (base == other.base) return overrides == other.overrides;
+    return toMap() == other.toMap();
+}
+
+void LabelTable::maybeRebase() {
+    size_t root = static_cast<size_t>(std::sqrt(static_cast<double>(base->size())));
+    size_t threshold = std::max(MIN_REBASE_THRESHOLD, root);
+    if (overrides.size() <= threshold) return;
+
+    base = std::make_shared<const Map>(toMap());
+    baseVersion = nextVersion();
+    overrides.clear();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @class LabelTable
+ * @brief Node-id -> label mapping shared between animation frames.
+ *
+ * A table is an immutable, reference-counted base map plus a small set of
+ * per-table overrides (new or changed labels, and erasures). Copying a table
+ * only copies the shared pointer and the overrides, so an algorithm can keep
+ * one running table, change the two slots a swap touches, and hand a cheap
+ * copy to every frame instead of re-stringifying every element.
+ *
+ * When the overrides grow past about the square root of the base size, they
+ * are folded into a new base (a new version); frames holding the old base
+ * keep it alive.
+ */
+class LabelTable {
+public:
+    using Map = std::map<std::string, std::string>;
+
+    LabelTable();
+    LabelTable(Map labels);
+
+    // Build a table whose base maps ids[i] -> std::to_string(values[i])
+    template <typename T>
+    static LabelTable fromValues(const std::vector<std::string>& ids, const std::vector<T>& values) {
+        Map labels;
+        for (size_t i = 0; i < ids.size() && i < values.size(); ++i) {
+            labels.emplace(ids[i], std::to_string(values[i]));
+        }
+        return LabelTable(std::move(labels));
+    }
+
+    void set(const std::string& id, std::string label);
+    void erase(const std::string& id);
+    void clear();
+
+    // Lookup; returns nullptr if the id has no label
+    const std::string* find(const std::string& id) const;
+    size_t count(const std::string& id) const { return find(id) ? 1 : 0; }
+    const std::string& at(const std::string& id) const;
+
+    bool empty() const;
+    size_t size() const;
+
+    // Visit every (id, label) pair in id order
+    void forEach(const std::function<void(const std::string&, const std::string&)>& fn) const;
+    Map toMap() const;
+
+    // Visit every id whose label differs between this table and 'other';
+    // a null pointer means "no label". Tables sharing a base only compare
+    // their overrides.
+    void diff(const LabelTable& other,
+        const std::function<void(const std::string&, const std::string*, const std::string*)>& fn) const;
+
+    // Version of the shared base; equal versions mean equal bases
+    uint64_t version() const { return baseVersion; }
+    size_t overrideCount() const { return overrides.size(); }
+
+    bool operator==(const LabelTable& other) const;
+    bool operator!=(const LabelTable& other) const { return !(*this == other); }
+
+private:
+    void maybeRebase();
+
+    std::shared_ptr<const Map> base;
+    uint64_t baseVersion{0};
+    std::map<std::string, std::optional<std::string>> overrides; // nullopt = erased
+};
@@ -0,0 +1,125 @@
+#include "layout_cache.h"
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+
+namespace {
+
+// FNV-1a, 64 bit
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+void hashBytes(uint64_t& h, const std::string& s) {
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= FNV_PRIME;
+    }
+    // Terminator, so "ab"+"c" and "a"+"bc" differ
+    h ^= 0xff;
+    h *= FNV_PRIME;
+}
+
+} // namespace
+
+LayoutCache::LayoutCache(size_t capacity)
+    : capacity(std::max<size_t>(1, capacity)) {
+}
+
+uint64_t LayoutCache::keyOf(const std::vector<std::string>& nodes, const std::vector<std::pair<int, int>>& edges,
+    const std::string& algorithm) {
+    std::vector<std::string> names(nodes);
+    std::sort(names.begin(), names.end());
+
+    std::vector<std::pair<std::string, std::string>> links;
+    links.reserve(edges.size());
+    for (const auto& [a, b] : edges) links.emplace_back(nodes[a], nodes[b]);
+    std::sort(links.begin(), links.end());
+
+    uint64_t h = FNV_OFFSET;
+    hashBytes(h, algorithm);
+    for (const auto& name : names) hashBytes(h, name);
+    hashBytes(h, "->");
+    for (const auto& [from, to] : links) {
+        hashBytes(h, from);
+        hashBytes(h, to);
+    }
+    return h;
+}
+
+const LayoutCache::Positions* LayoutCache::find(uint64_t key) {
+    auto it = index.find(key);
+    if (it == index.end()) return nullptr;
+    entries.splice(entries.begin(), entries, it->second);
+    return &it->second->second;
+}
+
+void LayoutCache::insert(uint64_t key, Positions positions) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = std::move(positions);
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    entries.emplace_front(key, std::move(positions));
+    index[key] = entries.begin();
+    while (entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+void LayoutCache::clear() {
+    entries.clear();
+    index.clear();
+}
+
+bool LayoutCache::save(const std::string& path) const {
+    QJsonArray layouts;
+    for (const auto& [key, positions] : entries) {
+        QJsonObject nodes;
+        for (const auto& [id, pos] : positions) nodes[QString::fromStdString(id)] = QJsonArray{ pos.first, pos.second };
+        QJsonObject layout;
+        layout["key"] = QString::number(key, 16);
+        layout["nodes"] = nodes;
+        layouts.append(layout);
+    }
+    QJsonObject root;
+    root["version"] = 1;
+    root["layouts"] = layouts;
+
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Failed to save layout cache";
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+bool LayoutCache::load(const std::string& path) {
+    QFile file(QString::fromStdString(path));
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) return false;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject() || doc.object()["version"].toInt() != 1) return false;
+
+    // Saved most recent first; insert oldest first to keep that order
+    const QJsonArray layouts = doc.object()["layouts"].toArray();
+    for (auto it = layouts.end(); it != layouts.begin();) {
+        const QJsonObject layout = (*--it).toObject();
+        bool ok = false;
+        const uint64_t key = layout["key"].toString().toULongLong(&ok, 16);
+        if (!ok) continue;
+        Positions positions;
+        const QJsonObject nodes = layout["nodes"].toObject();
+        for (auto n = nodes.begin(); n != nodes.end(); ++n) {
+            const QJsonArray pos = n.value().toArray();
+            if (pos.size() == 2) positions[n.key().toStdString()] = { pos[0].toDouble(), pos[1].toDouble() };
+        }
+        if (!positions.empty()) insert(key, std::move(positions));
+    }
+    qDebug() << "Loaded layout cache:" << entries.size() << "layouts";
+    return true;
+}
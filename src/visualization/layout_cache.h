@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class LayoutCache
+ * @brief Computed layouts, keyed by graph topology and layout algorithm.
+ *
+ * The key hashes the sorted node names and edges, so the same structure
+ * maps to the same entry however its DOT was written. The cache holds at
+ * most 'capacity' layouts and drops the least recently used one first. It
+ * can be saved to and loaded from a JSON file kept next to the session.
+ */
+class LayoutCache {
+public:
+    using Positions = std::map<std::string, std::pair<double, double>>;
+
+    explicit LayoutCache(size_t capacity = 32);
+
+    static uint64_t keyOf(const std::vector<std::string>& nodes, const std::vector<std::pair<int, int>>& edges,
+        const std::string& algorithm);
+
+    // Cached layout or nullptr; a hit becomes the most recently used entry
+    const Positions* find(uint64_t key);
+    void insert(uint64_t key, Positions positions);
+    void clear();
+    size_t size() const { return entries.size(); }
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    using Entry = std::pair<uint64_t, Positions>;
+
+    size_t capacity;
+    std::list<Entry> entries;   // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+};
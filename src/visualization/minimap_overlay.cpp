@@ -0,0 +1,158 @@
+#include "minimap_overlay.h"
+#include "visualization_renderer.h"
+#include <QEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Fraction of the content size kept free around it, so small moves stay incremental
+constexpr double COVER_SLACK = 0.15;
+
+QRgb densityColor(int count) {
+    if (count <= 0) return 0;
+    int alpha = std::min(255, 110 + static_cast<int>(45 * std::log2(static_cast<double>(count))));
+    return qPremultiply(qRgba(52, 152, 219, alpha));
+}
+
+} // namespace
+
+MinimapOverlay::MinimapOverlay(VisualizationRenderer* renderer)
+    : QWidget(renderer), renderer(renderer) {
+    setFixedSize(MAP_WIDTH, MAP_HEIGHT);
+    setCursor(Qt::PointingHandCursor);
+    setToolTip("Overview: click or drag to move the view");
+
+    density = QImage(MAP_WIDTH, MAP_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+    density.fill(Qt::transparent);
+    counts.assign(MAP_WIDTH * MAP_HEIGHT, 0);
+
+    // Scene changes arrive at animation rate; the density is refreshed at most every REFRESH_MS
+    refreshTimer = new QTimer(this);
+    refreshTimer->setSingleShot(true);
+    refreshTimer->setInterval(REFRESH_MS);
+    connect(refreshTimer, &QTimer::timeout, this, &MinimapOverlay::refreshDensity);
+    connect(renderer, &VisualizationRenderer::sceneChanged, this, &MinimapOverlay::scheduleRefresh);
+    connect(renderer, &VisualizationRenderer::viewChanged, this, [this]() { update(); });
+
+    renderer->installEventFilter(this);
+    placeInCorner();
+    hide();
+}
+
+void MinimapOverlay::scheduleRefresh() {
+    if (!refreshTimer->isActive()) refreshTimer->start();
+}
+
+bool MinimapOverlay::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == renderer && event->type() == QEvent::Resize) {
+        placeInCorner();
+        update();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void MinimapOverlay::placeInCorner() {
+    move(renderer->width() - width() - CORNER_MARGIN, renderer->height() - height() - CORNER_MARGIN);
+}
+
+int MinimapOverlay::cellAt(const QPointF& scenePos) const {
+    const QPointF p = toMap(scenePos);
+    const int x = static_cast<int>(std::floor(p.x()));
+    const int y = static_cast<int>(std::floor(p.y()));
+    if (x < 0 || y < 0 || x >= MAP_WIDTH || y >= MAP_HEIGHT) return -1;
+    return y * MAP_WIDTH + x;
+}
+
+QPointF MinimapOverlay::toMap(const QPointF& scenePos) const {
+    return (scenePos - origin) * scale;
+}
+
+QPointF MinimapOverlay::toScene(const QPointF& mapPos) const {
+    return origin + mapPos / scale;
+}
+
+void MinimapOverlay::plot(int cell, int delta) {
+    if (cell < 0) return;
+    counts[cell] += delta;
+    density.setPixel(cell % MAP_WIDTH, cell / MAP_WIDTH, densityColor(counts[cell]));
+}
+
+void MinimapOverlay::rebuild() {
+    const auto& nodes = renderer->scene().nodes();
+    QRectF content;
+    for (const auto& node : nodes) content |= node.bounds;
+    const double slack = COVER_SLACK * std::max(content.width(), content.height()) + 50.0;
+    content.adjust(-slack, -slack, slack, slack);
+
+    // Fit the content into the map, keeping its aspect ratio, centered
+    scale = std::min(MAP_WIDTH / content.width(), MAP_HEIGHT / content.height());
+    const QPointF mapSpan(MAP_WIDTH / scale, MAP_HEIGHT / scale);
+    origin = content.center() - mapSpan / 2.0;
+    covered = QRectF(origin, QSizeF(mapSpan.x(), mapSpan.y()));
+
+    density.fill(Qt::transparent);
+    std::fill(counts.begin(), counts.end(), 0);
+    cellOf.assign(nodes.size(), -1);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        cellOf[i] = cellAt(nodes[i].center);
+        plot(cellOf[i], 1);
+    }
+}
+
+void MinimapOverlay::refreshDensity() {
+    const auto& nodes = renderer->scene().nodes();
+    if (nodes.empty()) {
+        cellOf.clear();
+        hide();
+        return;
+    }
+
+    bool needsRebuild = cellOf.size() != nodes.size();
+    for (size_t i = 0; i < nodes.size() && !needsRebuild; ++i) {
+        if (!covered.contains(nodes[i].center)) {
+            needsRebuild = true;
+            break;
+        }
+        const int cell = cellAt(nodes[i].center);
+        if (cell == cellOf[i]) continue;
+        plot(cellOf[i], -1);
+        plot(cell, 1);
+        cellOf[i] = cell;
+    }
+    if (needsRebuild) rebuild();
+
+    show();
+    update();
+}
+
+void MinimapOverlay::paintEvent(QPaintEvent*) {
+    QPainter p(this);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(QPen(QColor("#BCCCDC"), 1));
+    p.setBrush(QColor(255, 255, 255, 220));
+    p.drawRoundedRect(QRectF(rect()).adjusted(0.5, 0.5, -0.5, -0.5), 4, 4);
+    p.drawImage(0, 0, density);
+
+    // What the canvas shows right now
+    const QRectF visible = renderer->visibleSceneRect();
+    QRectF frame(toMap(visible.topLeft()), toMap(visible.bottomRight()));
+    p.setPen(QPen(QColor("#E74C3C"), 1.5));
+    p.setBrush(QColor(231, 76, 60, 30));
+    p.drawRect(frame.intersected(QRectF(rect()).adjusted(1, 1, -1, -1)));
+}
+
+void MinimapOverlay::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton) return;
+    renderer->centerOn(toScene(QPointF(event->pos())));
+    event->accept();
+}
+
+void MinimapOverlay::mouseMoveEvent(QMouseEvent* event) {
+    if (!(event->buttons() & Qt::LeftButton)) return;
+    renderer->centerOn(toScene(QPointF(event->pos())));
+    event->accept();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QImage>
+#include <QPointF>
+#include <QRectF>
+#include <QWidget>
+#include <vector>
+
+class QTimer;
+class VisualizationRenderer;
+
+/**
+ * @class MinimapOverlay
+ * @brief Overview of the whole scene in a corner of the canvas.
+ *
+ * Shows a low-resolution density image of the node positions and the
+ * rectangle the canvas currently shows. The image keeps a node count per
+ * pixel and, when the scene changes, only re-plots the nodes whose pixel
+ * changed; it is rebuilt when nodes leave the covered area or the node
+ * count changes. Clicking or dragging centers the canvas on that point,
+ * which goes through the renderer's pan fast path.
+ */
+class MinimapOverlay : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit MinimapOverlay(VisualizationRenderer* renderer);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+    void scheduleRefresh();
+    void refreshDensity();
+
+private:
+    static constexpr int MAP_WIDTH = 200;
+    static constexpr int MAP_HEIGHT = 140;
+    static constexpr int CORNER_MARGIN = 10;
+    static constexpr int REFRESH_MS = 100;
+
+    void rebuild();
+    // Cell (pixel index) of a scene point, -1 outside the covered area
+    int cellAt(const QPointF& scenePos) const;
+    void plot(int cell, int delta);
+    QPointF toScene(const QPointF& mapPos) const;
+    QPointF toMap(const QPointF& scenePos) const;
+    void placeInCorner();
+
+    VisualizationRenderer* renderer;
+    QTimer* refreshTimer;
+
+    QImage density;            // one pixel per cell
+    std::vector<int> counts;   // nodes per cell
+    std::vector<int> cellOf;   // node index -> cell it is plotted in, -1 if none
+    QPointF origin;            // scene point at the image's top-left corner
+    double scale{ 1.0 };       // image pixels per scene unit
+    QRectF covered;            // scene area the image covers
+};
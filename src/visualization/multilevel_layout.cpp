@@ -0,0 +1,136 @@
+#include "multilevel_layout.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+MultilevelLayout::MultilevelLayout(const Options& options)
+    : opts(options) {
+}
+
+MultilevelLayout::Level MultilevelLayout::coarsen(Level& fine, unsigned seed) const {
+    std::vector<std::vector<int>> adjacent(fine.nodeCount);
+    for (const auto& [a, b] : fine.edges) {
+        adjacent[a].push_back(b);
+        adjacent[b].push_back(a);
+    }
+
+    std::vector<int> order(fine.nodeCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 rng(seed);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    Level coarse;
+    fine.parent.assign(fine.nodeCount, -1);
+
+    // Match each node with its lightest unmatched neighbor, keeping clusters balanced
+    for (int u : order) {
+        if (fine.parent[u] >= 0) continue;
+        int best = -1;
+        for (int v : adjacent[u]) {
+            if (v != u && fine.parent[v] < 0 && (best < 0 || fine.mass[v] < fine.mass[best])) best = v;
+        }
+        if (best < 0) continue;
+        fine.parent[u] = fine.parent[best] = coarse.nodeCount++;
+        coarse.mass.push_back(fine.mass[u] + fine.mass[best]);
+    }
+
+    // Leftovers (e.g. the leaves of a star) join their lightest neighbor's cluster
+    for (int u : order) {
+        if (fine.parent[u] >= 0) continue;
+        int best = -1;
+        for (int v : adjacent[u]) {
+            if (fine.parent[v] >= 0 && (best < 0 || coarse.mass[fine.parent[v]] < coarse.mass[fine.parent[best]])) best = v;
+        }
+        if (best >= 0) {
+            fine.parent[u] = fine.parent[best];
+            coarse.mass[fine.parent[u]] += fine.mass[u];
+        } else {
+            fine.parent[u] = coarse.nodeCount++;
+            coarse.mass.push_back(fine.mass[u]);
+        }
+    }
+
+    coarse.edges.reserve(fine.edges.size());
+    for (const auto& [a, b] : fine.edges) {
+        int pa = fine.parent[a], pb = fine.parent[b];
+        if (pa == pb) continue;
+        coarse.edges.emplace_back(std::min(pa, pb), std::max(pa, pb));
+    }
+    std::sort(coarse.edges.begin(), coarse.edges.end());
+    coarse.edges.erase(std::unique(coarse.edges.begin(), coarse.edges.end()), coarse.edges.end());
+    return coarse;
+}
+
+std::vector<ForceLayout::Point> MultilevelLayout::runLevel(const std::vector<Level>& levels, int level,
+    const ForceLayout::Options& options, std::vector<ForceLayout::Point> initial) {
+    ForceLayout layout(options);
+    if (progress) {
+        // Input node -> its cluster on this level, and the spread still to come
+        std::vector<int> cluster(levels[0].nodeCount);
+        for (int i = 0; i < levels[0].nodeCount; ++i) {
+            int c = i;
+            for (int l = 0; l < level; ++l) c = levels[l].parent[c];
+            cluster[i] = c;
+        }
+        const double spread = std::sqrt(static_cast<double>(levels[0].nodeCount) / levels[level].nodeCount);
+        std::vector<ForceLayout::Point> expanded(levels[0].nodeCount);
+        layout.setProgressCallback([this, cluster = std::move(cluster), spread, expanded](const std::vector<ForceLayout::Point>& pos) mutable {
+            for (size_t i = 0; i < cluster.size(); ++i) expanded[i] = { pos[cluster[i]].x * spread, pos[cluster[i]].y * spread };
+            return progress(expanded);
+        });
+    }
+    std::vector<ForceLayout::Point> pos = layout.run(levels[level].nodeCount, levels[level].edges, std::move(initial));
+    wasCancelled = layout.cancelled();
+    return pos;
+}
+
+std::vector<ForceLayout::Point> MultilevelLayout::run(int nodeCount, const std::vector<std::pair<int, int>>& edges) {
+    lastLevels = 0;
+    wasCancelled = false;
+    if (nodeCount <= 0) return {};
+
+    // Level 0 is the input without self-loops, duplicates or direction
+    std::vector<Level> levels(1);
+    levels[0].nodeCount = nodeCount;
+    levels[0].mass.assign(nodeCount, 1);
+    for (const auto& [a, b] : edges) {
+        if (a == b || a < 0 || b < 0 || a >= nodeCount || b >= nodeCount) continue;
+        levels[0].edges.emplace_back(std::min(a, b), std::max(a, b));
+    }
+    std::sort(levels[0].edges.begin(), levels[0].edges.end());
+    levels[0].edges.erase(std::unique(levels[0].edges.begin(), levels[0].edges.end()), levels[0].edges.end());
+
+    while (levels.back().nodeCount > opts.coarsestSize) {
+        Level coarse = coarsen(levels.back(), opts.force.seed + static_cast<unsigned>(levels.size()));
+        if (coarse.nodeCount > MIN_SHRINK * levels.back().nodeCount) {
+            levels.back().parent.clear();
+            break;
+        }
+        levels.push_back(std::move(coarse));
+    }
+    lastLevels = static_cast<int>(levels.size());
+
+    std::vector<ForceLayout::Point> pos = runLevel(levels, lastLevels - 1, opts.force, {});
+
+    ForceLayout::Options refineOpts = opts.force;
+    refineOpts.maxIterations = opts.refineIterations;
+    refineOpts.temperature = opts.force.edgeLength;
+    const double k = opts.force.edgeLength;
+    std::mt19937 rng(opts.force.seed);
+    std::uniform_real_distribution<double> jitter(-0.1 * k, 0.1 * k);
+
+    for (int l = static_cast<int>(levels.size()) - 2; l >= 0 && !wasCancelled; --l) {
+        const Level& fine = levels[l];
+        // Spread the coarse layout to the area the finer node count needs
+        const double spread = std::sqrt(static_cast<double>(fine.nodeCount) / levels[l + 1].nodeCount);
+        std::vector<ForceLayout::Point> finePos(fine.nodeCount);
+        for (int i = 0; i < fine.nodeCount; ++i) {
+            const ForceLayout::Point& p = pos[fine.parent[i]];
+            finePos[i] = { p.x * spread + jitter(rng), p.y * spread + jitter(rng) };
+        }
+        pos = runLevel(levels, l, refineOpts, std::move(finePos));
+    }
+    if (wasCancelled) return {};
+    return pos;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "force_layout.h"
+#include <utility>
+#include <vector>
+
+/**
+ * @class MultilevelLayout
+ * @brief Multilevel force-directed layout for large graphs (sfdp/FM³ style).
+ *
+ * The graph is coarsened repeatedly by merging matched neighbors (an
+ * unmatched node joins its lightest matched neighbor) until it is small or
+ * stops shrinking. The coarsest graph gets a full ForceLayout run; each
+ * finer level starts from its parent's position, spread out to the larger
+ * node count, and is only refined with a few cool iterations. Progress
+ * reports place every input node at its cluster's current position.
+ */
+class MultilevelLayout {
+public:
+    struct Options {
+        ForceLayout::Options force;
+        int coarsestSize{ 50 };      // stop coarsening at this many nodes
+        int refineIterations{ 60 };  // per finer level
+    };
+
+    explicit MultilevelLayout(const Options& options);
+
+    // Called with positions for all input nodes; returning false cancels
+    void setProgressCallback(ForceLayout::ProgressCallback callback) { progress = std::move(callback); }
+
+    std::vector<ForceLayout::Point> run(int nodeCount, const std::vector<std::pair<int, int>>& edges);
+
+    int levels() const { return lastLevels; }
+    bool cancelled() const { return wasCancelled; }
+
+private:
+    // A level stops coarsening when it keeps more than this share of its nodes
+    static constexpr double MIN_SHRINK = 0.85;
+
+    struct Level {
+        int nodeCount{ 0 };
+        std::vector<std::pair<int, int>> edges;
+        std::vector<int> mass;      // finest nodes merged into each node
+        std::vector<int> parent;    // node -> node of the next coarser level
+    };
+
+    // Fills fine.parent and returns the next coarser level
+    Level coarsen(Level& fine, unsigned seed) const;
+    // Runs one level, reporting its positions to 'progress' as input node positions
+    std::vector<ForceLayout::Point> runLevel(const std::vector<Level>& levels, int level,
+        const ForceLayout::Options& options, std::vector<ForceLayout::Point> initial);
+
+    Options opts;
+    ForceLayout::ProgressCallback progress;
+    int lastLevels{ 0 };
+    bool wasCancelled{ false };
+};
@@ -0,0 +1,43 @@
+#include "offscreen_renderer.h"
+#include <QPainter>
+#include <algorithm>
+
+OffscreenRenderer::OffscreenRenderer(const Options& options)
+    : opts(options) {
+    opts.size = opts.size.expandedTo(QSize(1, 1));
+    renderList.setBaseFont(opts.font);
+}
+
+QImage OffscreenRenderer::render(const AnimationFrame& frame) {
+    renderList.compile(frame, opts.nodeRadius);
+
+    double zoom = opts.zoom;
+    QPointF pan = opts.pan;
+    if (opts.fitToContent) fitCamera(zoom, pan);
+
+    QImage image(opts.size, QImage::Format_ARGB32_Premultiplied);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    // Labels and sprites are drawn with p.font(), so match the configured font
+    p.setFont(opts.font);
+    framePainter.paintScene(p, FramePainter::camera(QSizeF(opts.size), zoom, pan), image.rect(), zoom);
+    p.end();
+    return image;
+}
+
+void OffscreenRenderer::fitCamera(double& zoom, QPointF& pan) const {
+    const auto& nodes = renderList.nodes();
+    if (nodes.empty()) return;
+
+    QRectF content;
+    for (const auto& node : nodes) content |= node.bounds;
+    content.adjust(-FIT_MARGIN_PX, -FIT_MARGIN_PX, FIT_MARGIN_PX, FIT_MARGIN_PX);
+
+    const double sx = opts.size.width() / std::max(1.0, content.width());
+    const double sy = opts.size.height() / std::max(1.0, content.height());
+    zoom = std::min({ sx, sy, MAX_FIT_ZOOM });
+
+    // The camera zooms around the image center, so moving the content center there is enough
+    const QPointF center(opts.size.width() / 2.0, opts.size.height() / 2.0);
+    pan = center - content.center();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QFont>
+#include <QImage>
+#include <QPointF>
+#include <QSize>
+#include "animation_frame.h"
+#include "frame_painter.h"
+#include "render_list.h"
+
+/**
+ * @class OffscreenRenderer
+ * @brief Renders AnimationFrames into QImages without a widget.
+ *
+ * Uses the same RenderList and FramePainter as VisualizationRenderer, so an
+ * exported image matches what the canvas shows. QImage painting does not
+ * need a display, which makes this usable from worker threads and under
+ * the offscreen platform plugin. An instance keeps its glyph caches between
+ * frames; use one instance per thread.
+ */
+class OffscreenRenderer {
+public:
+    struct Options {
+        QSize size{ 1280, 720 };
+        int nodeRadius{ 20 };
+        QFont font;
+        // When set, zoom and pan are computed per frame so every node is visible
+        bool fitToContent{ true };
+        double zoom{ 1.0 };
+        QPointF pan;
+    };
+
+    explicit OffscreenRenderer(const Options& options);
+
+    QImage render(const AnimationFrame& frame);
+
+    const Options& options() const { return opts; }
+
+private:
+    static constexpr double FIT_MARGIN_PX = 24.0;
+    static constexpr double MAX_FIT_ZOOM = 2.0;
+
+    // Zoom and pan that frame the compiled nodes inside the image
+    void fitCamera(double& zoom, QPointF& pan) const;
+
+    Options opts;
+    RenderList renderList;
+    FramePainter framePainter{ renderList, opts.nodeRadius };
+};
@@ -1,5 +1,7 @@
 #include "playback_controller.h"
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
 
 PlaybackController::PlaybackController(QObject* parent)
     : QObject(parent),
@@ -7,6 +9,8 @@ PlaybackController::PlaybackController(QObject* parent)
     playbackSpeed(1.0f)
 {
     timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setTimerType(Qt::PreciseTimer);
     connect(timer, &QTimer::timeout, this, &PlaybackController::onTimeout);
 }
 
@@ -14,63 +18,302 @@ PlaybackController::~PlaybackController() = default;
 
 void PlaybackController::loadFrames(const std::vector<AnimationFrame>& frames_)
 {
-    frames = frames_;
+    stopPlayback();
+    timeline.reset();
+    deltas.clear();
+    checkpoints.clear();
+    durations.clear();
+
+    int count = static_cast<int>(frames_.size());
+    deltas.reserve(count > 0 ? count - 1 : 0);
+    durations.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        durations.push_back(frames_[i].duration);
+        if (i % CHECKPOINT_INTERVAL == 0) checkpoints.push_back(frames_[i]);
+        if (i + 1 < count) deltas.push_back(FrameDelta::between(frames_[i], frames_[i + 1]));
+    }
+    cursor = count > 0 ? frames_[0] : AnimationFrame();
+    cursorIndex = count > 0 ? 0 : -1;
+
     currentFrame = 0;
-    qDebug() << "PlaybackController: Loaded" << frames.size() << "frames";
+    rebuildOperationIndex([&frames_](int i) {
+        std::vector<std::string> types{ frames_[i].operationType };
+        types.insert(types.end(), frames_[i].mergedOperations.begin(), frames_[i].mergedOperations.end());
+        return types;
+    });
+    qDebug() << "PlaybackController: Loaded" << count << "frames";
+    emit framesLoaded(frameCount());
     
-    if (!frames.empty()) {
+    if (count > 0) {
         qDebug() << "PlaybackController: Emitting first frame";
-        emit frameReady(frames[currentFrame]);
+        showFrame(0);
+    }
+}
+
+void PlaybackController::loadTimeline(std::shared_ptr<TimelineReader> reader)
+{
+    stopPlayback();
+    deltas.clear();
+    checkpoints.clear();
+    durations.clear();
+    cursor = AnimationFrame();
+    cursorIndex = -1;
+    timeline = std::move(reader);
+    currentFrame = 0;
+    // Recordings are indexed from the file's frame index without decoding any block
+    rebuildOperationIndex([this](int i) { return timeline->operationTypesAt(i); });
+    qDebug() << "PlaybackController: Loaded timeline with" << frameCount() << "frames";
+    emit framesLoaded(frameCount());
+
+    if (frameCount() > 0) {
+        showFrame(0);
+    }
+}
+
+int PlaybackController::frameCount() const
+{
+    if (timeline) return timeline->frameCount();
+    return static_cast<int>(durations.size());
+}
+
+AnimationFrame PlaybackController::frameAt(int index)
+{
+    if (timeline) return timeline->frameAt(index);
+    moveCursor(index);
+    return cursor;
+}
+
+void PlaybackController::moveCursor(int index)
+{
+    // Restart from a checkpoint when one is closer than the cursor
+    int below = index / CHECKPOINT_INTERVAL;
+    int above = std::min(below + 1, static_cast<int>(checkpoints.size()) - 1);
+    for (int checkpoint : { below, above }) {
+        int checkpointIndex = checkpoint * CHECKPOINT_INTERVAL;
+        if (std::abs(index - checkpointIndex) < std::abs(index - cursorIndex)) {
+            cursor = checkpoints[checkpoint];
+            cursorIndex = checkpointIndex;
+        }
     }
+
+    while (cursorIndex < index) deltas[cursorIndex++].apply(cursor);
+    while (cursorIndex > index) deltas[--cursorIndex].revert(cursor);
+}
+
+void PlaybackController::showFrame(int index)
+{
+    currentFrame = index;
+    emit frameReady(frameAt(currentFrame));
+    emit positionChanged(currentFrame, frameCount());
+}
+
+void PlaybackController::rebuildOperationIndex(const std::function<std::vector<std::string>(int)>& typesAt)
+{
+    operationIndex.clear();
+    operationOrder.clear();
+
+    // Frames are visited in order, so each list comes out sorted. A merged
+    // frame is listed under every operation folded into it.
+    int count = frameCount();
+    for (int i = 0; i < count; ++i) {
+        for (const std::string& type : typesAt(i)) {
+            if (type.empty()) continue;
+            auto& list = operationIndex[type];
+            if (list.empty()) operationOrder.push_back(type);
+            if (list.empty() || list.back() != i) list.push_back(i);
+        }
+    }
+}
+
+qint64 PlaybackController::scaledDuration(int index) const
+{
+    int duration = timeline ? timeline->durationAt(index) : durations[index];
+    if (duration <= 0) duration = DEFAULT_FRAME_MS;
+    return std::max<qint64>(1, static_cast<qint64>(duration / playbackSpeed));
+}
+
+qint64 PlaybackController::slotLength(int index) const
+{
+    return turbo ? TURBO_TICK_MS : scaledDuration(index);
+}
+
+void PlaybackController::scheduleNext()
+{
+    qint64 wait = nextDue - clock.elapsed();
+    timer->start(static_cast<int>(std::max<qint64>(0, wait)));
+}
+
+void PlaybackController::resyncDeadline()
+{
+    // After a seek the new frame gets its full slot, starting now
+    if (!playing) return;
+    nextDue = clock.elapsed() + slotLength(currentFrame);
+    scheduleNext();
+}
+
+void PlaybackController::stopPlayback()
+{
+    timer->stop();
+    playing = false;
 }
 
 void PlaybackController::play()
 {
-    if (!frames.empty() && !timer->isActive()) {
-        // Default: 500ms per frame, adjusted by playback speed
-        // playbackSpeed of 1.0 = normal, 2.0 = 2x faster, 0.5 = 2x slower
-        int interval = static_cast<int>(500 / playbackSpeed);  // ms per frame
-        qDebug() << "PlaybackController: Starting playback with interval" << interval << "ms (speed:" << playbackSpeed << "x)";
-   timer->start(interval);
+    startPlayback(1);
+}
+
+void PlaybackController::playReverse()
+{
+    startPlayback(-1);
+}
+
+void PlaybackController::startPlayback(int step)
+{
+    if (frameCount() > 0 && !playing) {
+        direction = step;
+        playing = true;
+        shownFrames = 1;
+        droppedFrames = 0;
+        lateFrames = 0;
+        clock.start();
+        nextDue = slotLength(currentFrame);
+        qDebug() << "PlaybackController: Starting" << (direction > 0 ? "playback" : "reverse playback")
+            << "at frame" << currentFrame << "(speed:" << playbackSpeed << "x)";
+        scheduleNext();
     }
 }
 
 void PlaybackController::pause()
 {
-    if (timer->isActive()) {
-     timer->stop();
-        qDebug() << "PlaybackController: Paused at frame" << currentFrame;
+    if (playing) {
+        stopPlayback();
+        qDebug() << "PlaybackController: Paused at frame" << currentFrame
+            << "- shown" << shownFrames << "dropped" << droppedFrames << "late" << lateFrames;
+        emit playbackStats(shownFrames, droppedFrames, lateFrames);
     }
 }
 
 void PlaybackController::stepForward()
 {
-    if (frames.empty()) return;
-    currentFrame = (currentFrame + 1) % frames.size();
+    int count = frameCount();
+    if (count == 0) return;
+    // Stops at the last frame, like stepBackward at the first
+    if (currentFrame >= count - 1) return;
+    showFrame(currentFrame + 1);
+    resyncDeadline();
     qDebug() << "PlaybackController: Stepped forward to frame" << currentFrame;
-    emit frameReady(frames[currentFrame]);
 }
 
 void PlaybackController::stepBackward()
 {
-    if (frames.empty()) return;
-    currentFrame = (currentFrame - 1 + static_cast<int>(frames.size())) % static_cast<int>(frames.size());
+    int count = frameCount();
+    if (count == 0) return;
+    // Stops at the first frame instead of wrapping to the end
+    if (currentFrame == 0) return;
+    showFrame(currentFrame - 1);
+    resyncDeadline();
     qDebug() << "PlaybackController: Stepped backward to frame" << currentFrame;
-    emit frameReady(frames[currentFrame]);
+}
+
+void PlaybackController::seekToFrame(int index)
+{
+    int count = frameCount();
+    if (count == 0) return;
+    showFrame(std::clamp(index, 0, count - 1));
+    resyncDeadline();
+}
+
+void PlaybackController::seekToStart()
+{
+    seekToFrame(0);
+}
+
+void PlaybackController::seekToEnd()
+{
+    seekToFrame(frameCount() - 1);
+}
+
+int PlaybackController::findOperation(const std::string& operationType, int from, bool forward) const
+{
+    auto it = operationIndex.find(operationType);
+    if (it == operationIndex.end()) return -1;
+    const std::vector<int>& list = it->second;
+
+    if (forward) {
+        // First occurrence strictly after 'from'
+        auto pos = std::upper_bound(list.begin(), list.end(), from);
+        return pos == list.end() ? -1 : *pos;
+    }
+    // Last occurrence strictly before 'from'
+    auto pos = std::lower_bound(list.begin(), list.end(), from);
+    return pos == list.begin() ? -1 : *(pos - 1);
+}
+
+bool PlaybackController::seekToNextOperation(const std::string& operationType)
+{
+    int index = findOperation(operationType, currentFrame, true);
+    if (index < 0) return false;
+    seekToFrame(index);
+    return true;
+}
+
+bool PlaybackController::seekToPreviousOperation(const std::string& operationType)
+{
+    int index = findOperation(operationType, currentFrame, false);
+    if (index < 0) return false;
+    seekToFrame(index);
+    return true;
 }
 
 void PlaybackController::setSpeed(float speed)
 {
+    if (speed <= 0.0f) return;
+    float previous = playbackSpeed;
     playbackSpeed = speed;
     qDebug() << "PlaybackController: Speed set to" << speed << "x";
- 
-    if (timer->isActive()) {
-        int interval = static_cast<int>(500 / playbackSpeed);
-        qDebug() << "PlaybackController: Restarting timer with new interval" << interval << "ms";
-        timer->start(interval);
+
+    if (playing && !turbo) {
+        // Rescale what is left of the current slot instead of restarting it
+        qint64 now = clock.elapsed();
+        qint64 remaining = std::max<qint64>(0, nextDue - now);
+        nextDue = now + static_cast<qint64>(remaining * previous / speed);
+        scheduleNext();
     }
 }
 
+void PlaybackController::setTurbo(bool enabled)
+{
+    if (turbo == enabled) return;
+    turbo = enabled;
+    qDebug() << "PlaybackController: Turbo" << (turbo ? "on" : "off");
+    resyncDeadline();
+}
+
+void PlaybackController::setTurboFramesPerTick(int frames)
+{
+    turboFramesPerTick = std::max(1, frames);
+}
+
+void PlaybackController::skipToEnd()
+{
+    int count = frameCount();
+    if (count == 0) return;
+
+    bool wasPlaying = playing;
+    pause();
+    // Only the final frame is decoded and shown; nothing in between is applied
+    showFrame(count - 1);
+    if (wasPlaying) emit animationComplete();
+}
+
+int PlaybackController::frameInterval() const
+{
+    if (turbo) return TURBO_TICK_MS;
+    // playbackSpeed of 1.0 = normal, 2.0 = 2x faster, 0.5 = 2x slower
+    if (frameCount() == 0) return static_cast<int>(DEFAULT_FRAME_MS / playbackSpeed);
+    return static_cast<int>(scaledDuration(currentFrame));
+}
+
 AnimationFrame PlaybackController::interpolateBetween(const AnimationFrame& f1,
     const AnimationFrame& f2,
     double t)
@@ -80,21 +323,45 @@ AnimationFrame PlaybackController::interpolateBetween(const AnimationFrame& f1,
 
 void PlaybackController::onTimeout()
 {
-    if (frames.empty()) return;
+    int count = frameCount();
+    if (count == 0 || !playing) return;
 
-    // Move to next frame
-    currentFrame++;
-    
-    // ? FIX: Check if we've reached the END of frames (not looped to 0)
-    if (currentFrame >= static_cast<int>(frames.size())) {
-        // Animation complete - stop and reset to last frame
-     currentFrame = static_cast<int>(frames.size()) - 1;
-pause();
-     qDebug() << "PlaybackController: Animation complete";
-        emit animationComplete();  // NEW: Emit completion signal
+    // Check if we've reached the END of frames (first frame when reversed)
+    int last = direction > 0 ? count - 1 : 0;
+    if (currentFrame == last) {
+        // Animation complete - stop on that frame
+        pause();
+        qDebug() << "PlaybackController: Animation complete";
+        emit animationComplete();
         return;
-}
-    
-  // Emit the current frame
-emit frameReady(frames[currentFrame]);
+    }
+
+    qint64 now = clock.elapsed();
+    if (now - nextDue > LATE_THRESHOLD_MS) ++lateFrames;
+
+    if (turbo) {
+        // Apply a batch of frames per elapsed tick, render only the last
+        qint64 ticks = 1 + std::max<qint64>(0, now - nextDue) / TURBO_TICK_MS;
+        qint64 step = std::max<qint64>(1, std::lround(turboFramesPerTick * playbackSpeed)) * ticks;
+        int next = static_cast<int>(std::clamp<qint64>(currentFrame + direction * step, 0, count - 1));
+        nextDue += ticks * TURBO_TICK_MS;
+        ++shownFrames;
+        showFrame(next);
+        scheduleNext();
+        return;
+    }
+
+    // Advance from the deadline, not from 'now', so lateness never adds up.
+    // Frames whose whole slot already passed (event loop stall) are dropped.
+    int next = currentFrame + direction;
+    nextDue += scaledDuration(next);
+    while (nextDue <= now && next != last) {
+        next += direction;
+        ++droppedFrames;
+        nextDue += scaledDuration(next);
+    }
+
+    ++shownFrames;
+    showFrame(next);
+    scheduleNext();
 }
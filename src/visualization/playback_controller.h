@@ -2,9 +2,16 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <vector>
+#include <memory>
+#include <functional>
+#include <string>
+#include <unordered_map>
 #include "animation_frame.h"
 #include "frame_interpolator.h"
+#include "frame_delta.h"
+#include "timeline_file.h"
 
 class PlaybackController : public QObject {
     Q_OBJECT
@@ -14,11 +21,53 @@ public:
     ~PlaybackController() override;
 
     void loadFrames(const std::vector<AnimationFrame>& frames_);
+    // Play a memory-mapped recording; frames are decoded on demand
+    void loadTimeline(std::shared_ptr<TimelineReader> reader);
+    int frameCount() const;
+    int currentIndex() const { return currentFrame; }
+    // Each frame stays on screen for its own duration divided by the speed.
+    // Deadlines are absolute times on a monotonic clock, so late ticks do not
+    // accumulate drift; frames whose whole slot passed during a stall are
+    // skipped (dropped) rather than played back in a burst.
     void play();
+    // Same scheduler, walking towards the first frame
+    void playReverse();
     void pause();
+    bool isPlaying() const { return playing; }
+    bool isReversed() const { return direction < 0; }
+
+    // Turbo: every display tick applies several frames and only the last one
+    // is emitted, so throughput is bound by frame application, not repaints.
+    // The number of frames per tick scales with the playback speed.
+    void setTurbo(bool enabled);
+    bool isTurbo() const { return turbo; }
+    void setTurboFramesPerTick(int frames);
+    // Stop playback and show the final state directly
+    void skipToEnd();
     void stepForward();
     void stepBackward();
+
+    // Random access. In-memory runs are stored as one running frame plus an
+    // invertible delta per step, with a checkpoint every CHECKPOINT_INTERVAL
+    // frames, so a seek applies or reverts at most that many deltas.
+    // Recordings are bounded by the keyframe interval. Operation lookups use
+    // a per-type index of frame numbers and a binary search.
+    void seekToFrame(int index);
+    void seekToStart();
+    void seekToEnd();
+    bool seekToNextOperation(const std::string& operationType);
+    bool seekToPreviousOperation(const std::string& operationType);
+    int findOperation(const std::string& operationType, int from, bool forward) const;
+    // Distinct operation types in order of first appearance
+    std::vector<std::string> operationTypes() const { return operationOrder; }
     void setSpeed(float speed);
+    // Milliseconds the current frame stays on screen at the current speed
+    int frameInterval() const;
+
+    // Scheduler statistics for the current play session
+    int shownFrameCount() const { return shownFrames; }
+    int droppedFrameCount() const { return droppedFrames; }
+    int lateFrameCount() const { return lateFrames; }
     AnimationFrame interpolateBetween(const AnimationFrame& f1,
         const AnimationFrame& f2,
         double t);
@@ -26,14 +75,54 @@ public:
 signals:
     void frameReady(const AnimationFrame& frame);
     void animationComplete();  // ? NEW: Signal when animation finishes
+    void framesLoaded(int count);
+    void positionChanged(int index, int count);
+    // Emitted when playback stops (pause or completion)
+    void playbackStats(int shown, int dropped, int late);
 
 private slots:
     void onTimeout();
 
 private:
-    std::vector<AnimationFrame> frames;
+    AnimationFrame frameAt(int index);
+    void showFrame(int index);
+    void moveCursor(int index);
+    void startPlayback(int step);
+    void rebuildOperationIndex(const std::function<std::vector<std::string>(int)>& typesAt);
+    qint64 scaledDuration(int index) const;
+    qint64 slotLength(int index) const;
+    void scheduleNext();
+    void resyncDeadline();
+    void stopPlayback();
+
+    // In-memory run: cursor is the materialized frame at cursorIndex;
+    // deltas[i] turns frame i into frame i + 1 and back
+    static constexpr int CHECKPOINT_INTERVAL = 64;
+    AnimationFrame cursor;
+    int cursorIndex{-1};
+    std::vector<FrameDelta> deltas;
+    std::vector<AnimationFrame> checkpoints; // frames 0, 64, 128, ...
+    std::vector<int> durations;
+    std::shared_ptr<TimelineReader> timeline; // set when playing a recording
+    std::unordered_map<std::string, std::vector<int>> operationIndex; // type -> sorted frame numbers
+    std::vector<std::string> operationOrder;
     int currentFrame{0};
     float playbackSpeed{1.0f};
     QTimer* timer{nullptr};
+
+    // Scheduler state: nextDue is when the current frame's slot ends, in
+    // milliseconds on 'clock'
+    static constexpr int DEFAULT_FRAME_MS = 500;
+    static constexpr int LATE_THRESHOLD_MS = 16;
+    static constexpr int TURBO_TICK_MS = 16;
+    QElapsedTimer clock;
+    qint64 nextDue{0};
+    bool playing{false};
+    int direction{1}; // +1 forward, -1 reverse
+    bool turbo{false};
+    int turboFramesPerTick{10};
+    int shownFrames{0};
+    int droppedFrames{0};
+    int lateFrames{0};
     FrameInterpolator interpolator;
 };
@@ -0,0 +1,370 @@
+#include "render_list.h"
+#include <QTransform>
+#include <cmath>
+
+namespace {
+
+constexpr double ARRAY_CELL_SIZE = 50.0;
+// Room for the highlight ring and pen width around a node
+constexpr double NODE_PAINT_MARGIN = 8.0;
+// Room for the arrowhead and pen width around an edge
+constexpr double EDGE_PAINT_MARGIN = 8.0;
+
+NodeShape shapeOf(const AnimationFrame& frame, const std::string& id) {
+    auto it = frame.nodeShapes.find(id);
+    if (it == frame.nodeShapes.end()) return NodeShape::Circle;
+    if (it->second == "ARRAY") return NodeShape::ArrayCell;
+    if (it->second == "RECT") return NodeShape::Rect;
+    return NodeShape::Circle;
+}
+
+// Array cells get a lighter "memory cell" background unless colored
+QColor fillFor(NodeShape shape, const AnimationFrame& frame, const std::string& id) {
+    auto it = frame.nodeColors.find(id);
+    QColor fill = it != frame.nodeColors.end() ? RenderList::resolveColor(it->second) : RenderList::defaultFill();
+    if (shape == NodeShape::ArrayCell && fill == RenderList::defaultFill()) return QColor("#E3F2FD");
+    return fill;
+}
+
+// Integer in the id used as the array index label ("arr_5" -> 5): the
+// first run of digits, -1 when there is none
+int parseIndexSlot(const std::string& id) {
+    size_t start = id.find_first_of("0123456789");
+    if (start == std::string::npos) return -1;
+    int value = 0;
+    for (size_t i = start; i < id.size() && id[i] >= '0' && id[i] <= '9'; ++i) {
+        if (value > 99999999) return -1;
+        value = value * 10 + (id[i] - '0');
+    }
+    return value;
+}
+
+QStaticText makeGlyph(const QString& text, const QFont& font) {
+    QStaticText glyph(text);
+    glyph.setTextFormat(Qt::PlainText);
+    glyph.setPerformanceHint(QStaticText::AggressiveCaching);
+    glyph.prepare(QTransform(), font);
+    return glyph;
+}
+
+QPointF centeredIn(const QRectF& rect, const QStaticText& glyph) {
+    QSizeF size = glyph.size();
+    return QPointF(rect.center().x() - size.width() / 2, rect.center().y() - size.height() / 2);
+}
+
+// Everything paintEvent may touch for a node, including the index label
+QRectF paintBounds(const RenderNode& node) {
+    QRectF r = node.bounds.adjusted(-NODE_PAINT_MARGIN, -NODE_PAINT_MARGIN, NODE_PAINT_MARGIN, NODE_PAINT_MARGIN);
+    if (node.shape == NodeShape::ArrayCell) r.setBottom(r.bottom() + 17);
+    return r;
+}
+
+// Whether two compiled nodes paint identically
+bool sameAppearance(const RenderNode& a, const QString& aLabel, const RenderNode& b, const QString& bLabel) {
+    return a.shape == b.shape && a.center == b.center && a.fill == b.fill && a.valueGlyph == b.valueGlyph
+        && a.indexSlot == b.indexSlot && aLabel == bLabel;
+}
+
+// Lets a frame that only recolors nodes keep the renderer's edge layer
+bool sameEdgeGeometry(const std::vector<RenderEdge>& a, const std::vector<RenderEdge>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].visible != b[i].visible || a[i].arrow != b[i].arrow || a[i].from != b[i].from || a[i].to != b[i].to) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+const QColor& RenderList::defaultFill() {
+    static const QColor fill("#3498db");
+    return fill;
+}
+
+QColor RenderList::resolveColor(const std::string& name) {
+    // Every palette name the algorithms use is a valid SVG/hex color name
+    QColor color(QString::fromStdString(name));
+    return color.isValid() ? color : defaultFill();
+}
+
+void RenderList::clear() {
+    nodeList.clear();
+    edgeList.clear();
+    highlightList.clear();
+    labelText.clear();
+    nodeGrid.clear();
+    edgeGrid.clear();
+    slotOf.clear();
+    edgesOf.clear();
+}
+
+void RenderList::setFonts(const QFont& value, const QFont& index) {
+    if (value == valueGlyphFont && index == indexGlyphFont) return;
+    valueGlyphFont = value;
+    indexGlyphFont = index;
+    valueGlyphs.clear();
+    valueGlyphOf.clear();
+    indexGlyphs.clear();
+}
+
+void RenderList::setBaseFont(const QFont& base) {
+    QFont value = base;
+    value.setBold(true);
+    QFont index = base;
+    index.setPointSize(8);
+    index.setBold(false);
+    setFonts(value, index);
+}
+
+int RenderList::valueGlyphFor(const std::string& text) {
+    auto it = valueGlyphOf.find(text);
+    if (it != valueGlyphOf.end()) return it->second;
+    int glyph = static_cast<int>(valueGlyphs.size());
+    valueGlyphs.push_back(makeGlyph(QString::fromStdString(text), valueGlyphFont));
+    valueGlyphOf.emplace(text, glyph);
+    return glyph;
+}
+
+void RenderList::ensureIndexGlyph(int slot) {
+    while (static_cast<int>(indexGlyphs.size()) <= slot) {
+        indexGlyphs.push_back(makeGlyph(QString::number(indexGlyphs.size()), indexGlyphFont));
+    }
+}
+
+void RenderList::placeNode(RenderNode& node, double x, double y) const {
+    node.center = QPointF(x, y);
+    switch (node.shape) {
+    case NodeShape::ArrayCell:
+        node.bounds = QRectF(x - ARRAY_CELL_SIZE / 2, y - ARRAY_CELL_SIZE / 2, ARRAY_CELL_SIZE, ARRAY_CELL_SIZE);
+        node.textRect = node.bounds;
+        if (node.valueGlyph >= 0) node.valuePos = centeredIn(node.bounds, valueGlyphs[node.valueGlyph]);
+        if (node.indexSlot >= 0) {
+            QRectF indexRect(x - ARRAY_CELL_SIZE / 2, y + ARRAY_CELL_SIZE / 2 + 2, ARRAY_CELL_SIZE, 15);
+            node.indexPos = centeredIn(indexRect, indexGlyphs[node.indexSlot]);
+        }
+        break;
+    case NodeShape::Rect: {
+        double w = radius * 3.0;
+        double h = radius * 1.5;
+        node.bounds = QRectF(x - w / 2, y - h / 2, w, h);
+        node.textRect = QRectF(x - w / 2, y - h / 2, w * 0.66, h);
+        break;
+    }
+    case NodeShape::Circle:
+        node.bounds = QRectF(x - radius, y - radius, 2 * radius, 2 * radius);
+        node.textRect = node.bounds;
+        break;
+    }
+}
+
+void RenderList::placeEdge(RenderEdge& edge) const {
+    const RenderNode& a = nodeList[edge.fromNode];
+    const RenderNode& b = nodeList[edge.toNode];
+    QPointF start = a.center;
+    QPointF end = b.center;
+    edge.visible = true;
+
+    if (edge.arrow) {
+        // List: line between list nodes with an arrowhead at the target
+        double w = radius * 3.0;
+        start.setX(start.x() + w / 2 - 10);
+        if (end.x() > start.x()) end.setX(end.x() - w / 2);
+        edge.arrowHead[0] = end;
+        edge.arrowHead[1] = QPointF(end.x() - 8, end.y() - 4);
+        edge.arrowHead[2] = QPointF(end.x() - 8, end.y() + 4);
+    } else {
+        // Circle: line between circle edges (accounts for radius)
+        double dx = end.x() - start.x();
+        double dy = end.y() - start.y();
+        double len = std::sqrt(dx * dx + dy * dy);
+        if (len <= 0) {
+            edge.visible = false;
+            return;
+        }
+        double ux = dx / len;
+        double uy = dy / len;
+        start = QPointF(start.x() + ux * radius, start.y() + uy * radius);
+        end = QPointF(end.x() - ux * radius, end.y() - uy * radius);
+    }
+    edge.from = start;
+    edge.to = end;
+}
+
+void RenderList::clearDirty() {
+    dirty.clear();
+    dirtyOverflowed = false;
+}
+
+void RenderList::markDirty(const RenderNode& node) {
+    if (dirtyOverflowed) return;
+    if (dirty.size() >= MAX_DIRTY_RECTS) {
+        dirtyOverflowed = true;
+        dirty.clear();
+        return;
+    }
+    dirty.push_back(paintBounds(node));
+}
+
+void RenderList::updateOverlap(int slot) {
+    RenderNode& node = nodeList[slot];
+    node.overlapped = false;
+    nodeGrid.query(node.bounds, overlapScratch);
+    for (int other : overlapScratch) {
+        if (other != slot && nodeList[other].bounds.intersects(node.bounds)) {
+            node.overlapped = true;
+            return;
+        }
+    }
+}
+
+void RenderList::indexEdge(int edge) {
+    const RenderEdge& e = edgeList[edge];
+    if (!e.visible) {
+        edgeGrid.remove(edge);
+        return;
+    }
+    QRectF bounds = QRectF(e.from, e.to).normalized();
+    edgeGrid.insert(edge, bounds.adjusted(-EDGE_PAINT_MARGIN, -EDGE_PAINT_MARGIN, EDGE_PAINT_MARGIN, EDGE_PAINT_MARGIN));
+}
+
+void RenderList::compile(const AnimationFrame& frame, int nodeRadius) {
+    // The previous compile is kept to work out what changed on screen
+    std::vector<RenderEdge> previousEdges;
+    std::vector<RenderNode> previousNodes;
+    std::vector<QString> previousLabels;
+    std::vector<int> previousHighlights;
+    std::unordered_map<std::string, int> previousSlots;
+    previousEdges.swap(edgeList);
+    previousNodes.swap(nodeList);
+    previousLabels.swap(labelText);
+    previousHighlights.swap(highlightList);
+    previousSlots.swap(slotOf);
+    clear();
+    radius = nodeRadius;
+    if (valueGlyphs.size() > MAX_VALUE_GLYPHS) {
+        valueGlyphs.clear();
+        valueGlyphOf.clear();
+    }
+
+    size_t count = frame.nodePositions.size();
+    nodeList.reserve(count);
+    labelText.reserve(count);
+    slotOf.reserve(count);
+    edgesOf.resize(count);
+
+    for (const auto& [id, position] : frame.nodePositions) {
+        RenderNode node{};
+        node.shape = shapeOf(frame, id);
+        node.fill = fillFor(node.shape, frame, id);
+        node.valueGlyph = -1;
+        node.indexSlot = -1;
+
+        const std::string* label = frame.nodeLabels.find(id);
+        const std::string& text = label ? *label : id;
+        if (node.shape == NodeShape::ArrayCell) {
+            // Array cells draw cached glyphs for the value and the index
+            node.valueGlyph = valueGlyphFor(text);
+            node.indexSlot = parseIndexSlot(id);
+            if (node.indexSlot >= 0) ensureIndexGlyph(node.indexSlot);
+            labelText.emplace_back();
+        } else {
+            labelText.push_back(QString::fromStdString(text));
+        }
+
+        placeNode(node, position.first, position.second);
+        int slot = static_cast<int>(nodeList.size());
+        slotOf.emplace(id, slot);
+        nodeGrid.insert(slot, paintBounds(node));
+        nodeList.push_back(node);
+    }
+
+    for (const auto& [src, dst] : frame.edges) {
+        auto a = slotOf.find(src);
+        auto b = slotOf.find(dst);
+        if (a == slotOf.end() || b == slotOf.end()) continue;
+
+        // Arrays are drawn as contiguous boxes, without edges
+        NodeShape shape = nodeList[a->second].shape;
+        if (shape == NodeShape::ArrayCell) continue;
+
+        RenderEdge edge{};
+        edge.fromNode = a->second;
+        edge.toNode = b->second;
+        edge.arrow = shape == NodeShape::Rect;
+        placeEdge(edge);
+
+        int index = static_cast<int>(edgeList.size());
+        edgeList.push_back(edge);
+        indexEdge(index);
+        edgesOf[edge.fromNode].push_back(index);
+        if (edge.toNode != edge.fromNode) edgesOf[edge.toNode].push_back(index);
+    }
+
+    for (size_t slot = 0; slot < nodeList.size(); ++slot) updateOverlap(static_cast<int>(slot));
+
+    if (!sameEdgeGeometry(previousEdges, edgeList)) ++edgeVersion;
+
+    for (const auto& id : frame.highlightedNodes) {
+        auto it = slotOf.find(id);
+        if (it != slotOf.end()) highlightList.push_back(it->second);
+    }
+
+    // Dirty rects: nodes that appeared, vanished or paint differently
+    for (const auto& [id, slot] : slotOf) {
+        auto before = previousSlots.find(id);
+        if (before == previousSlots.end()) {
+            markDirty(nodeList[slot]);
+            continue;
+        }
+        const RenderNode& old = previousNodes[before->second];
+        if (sameAppearance(old, previousLabels[before->second], nodeList[slot], labelText[slot])) continue;
+        markDirty(old);
+        markDirty(nodeList[slot]);
+    }
+    for (const auto& [id, slot] : previousSlots) {
+        if (!slotOf.count(id)) markDirty(previousNodes[slot]);
+    }
+
+    // Highlight halos: if the set moved, repaint where it was and where it is
+    bool sameHighlights = previousHighlights.size() == highlightList.size();
+    for (size_t i = 0; sameHighlights && i < highlightList.size(); ++i) {
+        sameHighlights = previousNodes[previousHighlights[i]].bounds == nodeList[highlightList[i]].bounds;
+    }
+    if (!sameHighlights) {
+        for (int slot : previousHighlights) markDirty(previousNodes[slot]);
+        for (int slot : highlightList) markDirty(nodeList[slot]);
+    }
+}
+
+void RenderList::refreshNode(const AnimationFrame& frame, const std::string& id) {
+    auto slot = slotOf.find(id);
+    auto position = frame.nodePositions.find(id);
+    if (slot == slotOf.end() || position == frame.nodePositions.end()) return;
+
+    RenderNode& node = nodeList[slot->second];
+    QColor fill = fillFor(node.shape, frame, id);
+    QPointF center(position->second.first, position->second.second);
+    if (fill == node.fill && center == node.center) return;
+
+    markDirty(node); // where it was
+    node.fill = fill;
+    if (center == node.center) return;
+
+    // Nodes it overlapped before or overlaps now may change their overlap flag
+    std::vector<int> neighbours;
+    nodeGrid.query(node.bounds, neighbours);
+    placeNode(node, center.x(), center.y());
+    nodeGrid.update(slot->second, paintBounds(node));
+    nodeGrid.query(node.bounds, overlapScratch);
+    neighbours.insert(neighbours.end(), overlapScratch.begin(), overlapScratch.end());
+    neighbours.push_back(slot->second);
+    for (int other : neighbours) updateOverlap(other);
+    markDirty(node); // where it is now
+    if (!edgesOf[slot->second].empty()) ++edgeVersion;
+    for (int edge : edgesOf[slot->second]) {
+        placeEdge(edgeList[edge]);
+        indexEdge(edge);
+    }
+}
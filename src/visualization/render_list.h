@@ -0,0 +1,129 @@
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QStaticText>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "animation_frame.h"
+#include "spatial_grid.h"
+
+enum class NodeShape : unsigned char { Circle, Rect, ArrayCell };
+
+// Paint-ready node: everything paintEvent needs, already resolved
+struct RenderNode {
+    QPointF center;
+    QRectF bounds;     // outline of the shape in scene coordinates
+    QRectF textRect;   // where the value label is drawn
+    QPointF valuePos;  // array cells: top-left of the centered value glyph
+    QPointF indexPos;  // array cells: top-left of the index glyph under the cell
+    QColor fill;
+    NodeShape shape;
+    int valueGlyph;    // array cells: slot in the value glyph cache, -1 if none
+    int indexSlot;     // array cells: integer index parsed from the id, -1 if none
+    bool overlapped;   // bounds intersect another node's: must be painted in scene order
+};
+
+// Paint-ready edge; list edges carry an arrowhead
+struct RenderEdge {
+    QPointF from;
+    QPointF to;
+    QPointF arrowHead[3];
+    bool arrow;
+    bool visible;      // false for zero-length edges
+    int fromNode;
+    int toNode;
+};
+
+/**
+ * @class RenderList
+ * @brief Flat, paint-ready form of an AnimationFrame.
+ *
+ * A frame is compiled once when it arrives: shape strings become enums,
+ * color names become QColors, labels become QStrings and geometry becomes
+ * scene rects. paintEvent then walks plain arrays instead of doing map
+ * lookups and string conversions per node on every repaint. During a tween
+ * only the nodes that move or change color are recompiled.
+ *
+ * Nodes and edges are also indexed in a SpatialGrid by their painted
+ * bounds, so the renderer only walks what intersects the viewport. Nodes
+ * that overlap another node are flagged; the painter may batch every other
+ * node out of scene order, but these keep their stacking order.
+ * edgeGeometryVersion() lets it keep a cached edge layer across frames
+ * that only recolor nodes.
+ */
+class RenderList {
+public:
+    void compile(const AnimationFrame& frame, int nodeRadius);
+    // Recompute position/color of one node (and the edges touching it)
+    void refreshNode(const AnimationFrame& frame, const std::string& id);
+    void clear();
+
+    // Bumped whenever edge geometry changes; color-only updates keep it
+    unsigned long long edgeGeometryVersion() const { return edgeVersion; }
+
+    // Scene rects of nodes (with their halos) that changed since clearDirty().
+    // dirtyOverflow() means too many to be worth tracking: repaint everything.
+    const std::vector<QRectF>& dirtyRects() const { return dirty; }
+    bool dirtyOverflow() const { return dirtyOverflowed; }
+    void clearDirty();
+
+    // Fonts the array glyphs are laid out with; changing them drops the caches
+    void setFonts(const QFont& value, const QFont& index);
+    // Derives the canvas fonts from a base font: bold values, 8pt indices
+    void setBaseFont(const QFont& base);
+    const QFont& valueFont() const { return valueGlyphFont; }
+    const QFont& indexFont() const { return indexGlyphFont; }
+
+    const std::vector<RenderNode>& nodes() const { return nodeList; }
+    const std::vector<RenderEdge>& edges() const { return edgeList; }
+    // Node indices to outline, in the frame's highlight order
+    const std::vector<int>& highlights() const { return highlightList; }
+    const QString& label(int node) const { return labelText[node]; }
+
+    // Indices of nodes / edges whose painted bounds intersect 'area' (scene coordinates)
+    void nodesIn(const QRectF& area, std::vector<int>& out) const { nodeGrid.query(area, out); }
+    void edgesIn(const QRectF& area, std::vector<int>& out) const { edgeGrid.query(area, out); }
+    const QStaticText& valueGlyph(int glyph) const { return valueGlyphs[glyph]; }
+    const QStaticText& indexGlyph(int slot) const { return indexGlyphs[slot]; }
+
+    static QColor resolveColor(const std::string& name);
+    static const QColor& defaultFill();
+
+private:
+    void placeNode(RenderNode& node, double x, double y) const;
+    void placeEdge(RenderEdge& edge) const;
+    void indexEdge(int edge);
+    void markDirty(const RenderNode& node);
+    void updateOverlap(int slot);
+    int valueGlyphFor(const std::string& text);
+    void ensureIndexGlyph(int slot);
+
+    int radius{ 20 };
+    unsigned long long edgeVersion{ 0 };
+    static constexpr size_t MAX_DIRTY_RECTS = 256;
+    std::vector<QRectF> dirty;
+    bool dirtyOverflowed{ false };
+    std::vector<RenderNode> nodeList;
+    std::vector<RenderEdge> edgeList;
+    std::vector<int> highlightList;
+    std::vector<QString> labelText;
+    SpatialGrid nodeGrid;
+    SpatialGrid edgeGrid;
+    std::vector<int> overlapScratch;
+
+    // Array glyphs survive recompiles: values repeat between frames and
+    // indices are shared by every array view
+    static constexpr size_t MAX_VALUE_GLYPHS = 4096;
+    QFont valueGlyphFont;
+    QFont indexGlyphFont;
+    std::vector<QStaticText> valueGlyphs;
+    std::unordered_map<std::string, int> valueGlyphOf;
+    std::vector<QStaticText> indexGlyphs;
+    std::unordered_map<std::string, int> slotOf;       // node id -> index
+    std::vector<std::vector<int>> edgesOf;             // node index -> edge indices
+};
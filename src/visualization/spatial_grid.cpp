@@ -0,0 +1,129 @@
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Cell coordinates are clamped so far-away items cannot overflow an int
+constexpr double MAX_CELL_COORD = 1 << 30;
+
+int cellCoord(double value, double cellSize) {
+    return static_cast<int>(std::clamp(std::floor(value / cellSize), -MAX_CELL_COORD, MAX_CELL_COORD));
+}
+
+// Closed-interval overlap: zero-width rects (straight edges) still count
+bool overlaps(const QRectF& a, const QRectF& b) {
+    return a.left() <= b.right() && b.left() <= a.right() && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+} // namespace
+
+SpatialGrid::SpatialGrid(double cellSize)
+    : cellSize(cellSize > 0 ? cellSize : 128.0) {
+}
+
+void SpatialGrid::clear() {
+    cells.clear();
+    oversized.clear();
+    itemBounds.clear();
+    states.clear();
+}
+
+long long SpatialGrid::keyOf(int x, int y) {
+    return static_cast<long long>((static_cast<unsigned long long>(static_cast<unsigned int>(x)) << 32) | static_cast<unsigned int>(y));
+}
+
+SpatialGrid::CellRange SpatialGrid::rangeOf(const QRectF& bounds) const {
+    QRectF r = bounds.normalized();
+    return { cellCoord(r.left(), cellSize), cellCoord(r.top(), cellSize),
+        cellCoord(r.right(), cellSize), cellCoord(r.bottom(), cellSize) };
+}
+
+void SpatialGrid::insert(int item, const QRectF& bounds) {
+    if (item < 0) return;
+    if (static_cast<size_t>(item) >= states.size()) {
+        states.resize(item + 1, Absent);
+        itemBounds.resize(item + 1);
+    }
+    if (states[item] != Absent) unlink(item);
+
+    itemBounds[item] = bounds.normalized();
+    CellRange range = rangeOf(bounds);
+    long long spanned = (static_cast<long long>(range.x1) - range.x0 + 1) * (static_cast<long long>(range.y1) - range.y0 + 1);
+    if (spanned > MAX_CELLS_PER_ITEM) {
+        oversized.push_back(item);
+        states[item] = Oversized;
+        return;
+    }
+
+    for (int x = range.x0; x <= range.x1; ++x) {
+        for (int y = range.y0; y <= range.y1; ++y) cells[keyOf(x, y)].push_back(item);
+    }
+    states[item] = Bucketed;
+}
+
+void SpatialGrid::update(int item, const QRectF& bounds) {
+    insert(item, bounds);
+}
+
+void SpatialGrid::remove(int item) {
+    if (item < 0 || static_cast<size_t>(item) >= states.size() || states[item] == Absent) return;
+    unlink(item);
+}
+
+void SpatialGrid::unlink(int item) {
+    if (states[item] == Oversized) {
+        oversized.erase(std::remove(oversized.begin(), oversized.end(), item), oversized.end());
+    } else {
+        CellRange range = rangeOf(itemBounds[item]);
+        for (int x = range.x0; x <= range.x1; ++x) {
+            for (int y = range.y0; y <= range.y1; ++y) {
+                auto it = cells.find(keyOf(x, y));
+                if (it == cells.end()) continue;
+                auto& bucket = it->second;
+                bucket.erase(std::remove(bucket.begin(), bucket.end(), item), bucket.end());
+                if (bucket.empty()) cells.erase(it);
+            }
+        }
+    }
+    states[item] = Absent;
+}
+
+void SpatialGrid::query(const QRectF& area, std::vector<int>& out) const {
+    out.clear();
+    if (states.empty()) return;
+
+    QRectF r = area.normalized();
+    CellRange range = rangeOf(r);
+    long long covered = (static_cast<long long>(range.x1) - range.x0 + 1) * (static_cast<long long>(range.y1) - range.y0 + 1);
+
+    if (covered > static_cast<long long>(cells.size())) {
+        // Zoomed far out: walking the occupied buckets is cheaper than the area
+        for (const auto& [key, bucket] : cells) {
+            int x = static_cast<int>(key >> 32);
+            int y = static_cast<int>(static_cast<unsigned int>(key & 0xffffffffLL));
+            if (x < range.x0 || x > range.x1 || y < range.y0 || y > range.y1) continue;
+            for (int item : bucket) {
+                if (overlaps(itemBounds[item], r)) out.push_back(item);
+            }
+        }
+    } else {
+        for (int x = range.x0; x <= range.x1; ++x) {
+            for (int y = range.y0; y <= range.y1; ++y) {
+                auto it = cells.find(keyOf(x, y));
+                if (it == cells.end()) continue;
+                for (int item : it->second) {
+                    if (overlaps(itemBounds[item], r)) out.push_back(item);
+                }
+            }
+        }
+    }
+    for (int item : oversized) {
+        if (overlaps(itemBounds[item], r)) out.push_back(item);
+    }
+
+    // Callers draw in index order, which keeps the stacking order stable.
+    // Items spanning several cells were found once per cell.
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
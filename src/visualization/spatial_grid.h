@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QRectF>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform grid from scene rectangles to item indices.
+ *
+ * Each item is bucketed into every cell its bounds overlap, so a viewport
+ * query only visits the cells it covers. Items that would span too many
+ * cells (long edges) go to a separate list that is tested directly.
+ * update() re-buckets a single item, which keeps the index valid while a
+ * tween moves a few nodes. query() does not modify the grid, so several
+ * threads may query it at once.
+ */
+class SpatialGrid {
+public:
+    explicit SpatialGrid(double cellSize = 128.0);
+
+    void clear();
+    void insert(int item, const QRectF& bounds);
+    void update(int item, const QRectF& bounds);
+    void remove(int item);
+
+    // Items whose bounds intersect 'area', each reported once, ascending
+    void query(const QRectF& area, std::vector<int>& out) const;
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;
+    };
+
+    enum State : unsigned char { Absent, Bucketed, Oversized };
+    static constexpr long long MAX_CELLS_PER_ITEM = 64;
+
+    CellRange rangeOf(const QRectF& bounds) const;
+    static long long keyOf(int x, int y);
+    void unlink(int item);
+
+    double cellSize;
+    std::unordered_map<long long, std::vector<int>> cells;
+    std::vector<int> oversized;
+    std::vector<QRectF> itemBounds;
+    std::vector<State> states;
+};
@@ -0,0 +1,107 @@
+#include "sprite_atlas.h"
+#include <QPainter>
+
+size_t SpriteAtlas::KeyHash::operator()(const Key& key) const {
+    size_t h = qHash(key.label);
+    h = h * 31 + key.fill;
+    h = h * 31 + key.shape;
+    h = h * 31 + static_cast<size_t>(key.size.width()) * 4099 + static_cast<size_t>(key.size.height());
+    return h;
+}
+
+SpriteAtlas::Sprite SpriteAtlas::SizeClass::spriteAt(int slot) const {
+    const int perRow = PAGE_SIZE / size.width();
+    const int inPage = slot % slotsPerPage;
+    Sprite sprite;
+    sprite.page = pages[slot / slotsPerPage].get();
+    sprite.source = QRect((inPage % perRow) * size.width(), (inPage / perRow) * size.height(), size.width(), size.height());
+    return sprite;
+}
+
+void SpriteAtlas::configure(double scale, int nodeRadius, const QFont& font) {
+    if (scale == rasterScale && nodeRadius == radius && font == labelFont) return;
+    clear();
+    rasterScale = scale;
+    radius = nodeRadius;
+    labelFont = font;
+}
+
+void SpriteAtlas::clear() {
+    classes.clear();
+    pageCount = 0;
+}
+
+SpriteAtlas::SizeClass& SpriteAtlas::sizeClassFor(const QSize& size) {
+    SizeClass& sizeClass = classes[{ size.width(), size.height() }];
+    if (sizeClass.slotsPerPage == 0) {
+        sizeClass.size = size;
+        sizeClass.slotsPerPage = (PAGE_SIZE / size.width()) * (PAGE_SIZE / size.height());
+    }
+    return sizeClass;
+}
+
+bool SpriteAtlas::find(const Key& key, Sprite& out) {
+    auto cls = classes.find({ key.size.width(), key.size.height() });
+    if (cls == classes.end()) return false;
+    SizeClass& sizeClass = cls->second;
+    auto it = sizeClass.entries.find(key);
+    if (it == sizeClass.entries.end()) return false;
+
+    Entry& entry = it->second;
+    entry.lastPaint = paintStamp;
+    sizeClass.lastPaint = paintStamp;
+    sizeClass.lru.splice(sizeClass.lru.begin(), sizeClass.lru, entry.order);
+    out = sizeClass.spriteAt(entry.slot);
+    return true;
+}
+
+bool SpriteAtlas::allocate(const Key& key, Sprite& out) {
+    if (key.size.width() <= 0 || key.size.height() <= 0 || key.size.width() > PAGE_SIZE || key.size.height() > PAGE_SIZE) return false;
+    SizeClass& sizeClass = sizeClassFor(key.size);
+
+    int slot = -1;
+    const bool pageFull = sizeClass.usedSlots == static_cast<int>(sizeClass.pages.size()) * sizeClass.slotsPerPage;
+    if (!pageFull) {
+        slot = sizeClass.usedSlots++;
+    } else if (pageCount < MAX_PAGES || releaseStaleClass(sizeClass)) {
+        auto page = std::make_unique<QImage>(PAGE_SIZE, PAGE_SIZE, QImage::Format_ARGB32_Premultiplied);
+        page->fill(Qt::transparent);
+        sizeClass.pages.push_back(std::move(page));
+        ++pageCount;
+        slot = sizeClass.usedSlots++;
+    } else {
+        // Reuse the least recently used slot, unless it is still on screen
+        if (sizeClass.lru.empty()) return false;
+        auto victim = sizeClass.entries.find(sizeClass.lru.back());
+        if (victim->second.lastPaint == paintStamp) return false;
+        slot = victim->second.slot;
+        sizeClass.lru.pop_back();
+        sizeClass.entries.erase(victim);
+    }
+
+    sizeClass.lastPaint = paintStamp;
+    sizeClass.lru.push_front(key);
+    sizeClass.entries.emplace(key, Entry{ slot, paintStamp, sizeClass.lru.begin() });
+    out = sizeClass.spriteAt(slot);
+    clearSlot(out);
+    return true;
+}
+
+bool SpriteAtlas::releaseStaleClass(const SizeClass& keep) {
+    auto stale = classes.end();
+    for (auto it = classes.begin(); it != classes.end(); ++it) {
+        const SizeClass& candidate = it->second;
+        if (&candidate == &keep || candidate.pages.empty() || candidate.lastPaint == paintStamp) continue;
+        if (stale == classes.end() || candidate.lastPaint < stale->second.lastPaint) stale = it;
+    }
+    if (stale == classes.end()) return false;
+    pageCount -= stale->second.pages.size();
+    classes.erase(stale);
+    return true;
+}
+
+void SpriteAtlas::clearSlot(const Sprite& sprite) {
+    QPainter p(sprite.page);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    p.fillRect(sprite.source, Qt::transparent);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SpriteAtlas
+ * @brief LRU cache of pre-rasterized node sprites packed into atlas pages.
+ *
+ * A sprite is one node (shape, fill and label) rasterized once at the
+ * current device scale. Sprites of the same pixel size share pages that
+ * are cut into a fixed grid of slots, so an evicted sprite's slot can be
+ * reused directly. Pages are QImages, which keeps the atlas usable from
+ * the offscreen renderer's worker threads.
+ *
+ * Memory is bounded by a page budget shared by all sizes. Once it is used
+ * up, a size not drawn in the current paint gives its pages back (say, the
+ * sprites of a previous zoom level) before sprites of the requested size
+ * are evicted in LRU order.
+ *
+ * The atlas does not know how to draw a node: allocate() hands out a
+ * cleared slot and the caller paints into it.
+ */
+class SpriteAtlas {
+public:
+    struct Key {
+        unsigned char shape;
+        QRgb fill;
+        QString label;
+        QSize size;  // device pixels
+
+        bool operator==(const Key& other) const {
+            return shape == other.shape && fill == other.fill && size == other.size && label == other.label;
+        }
+    };
+
+    struct Sprite {
+        QImage* page{ nullptr };
+        QRect source;  // slot inside 'page', in pixels
+    };
+
+    // Drops every sprite when the raster scale, node radius or font changes
+    void configure(double scale, int nodeRadius, const QFont& font);
+    double scale() const { return rasterScale; }
+
+    // Starts a paint: sprites used from here on are not evicted until the next call
+    void beginPaint() { ++paintStamp; }
+
+    bool find(const Key& key, Sprite& out);
+    // Reserves a transparent slot for 'key'. Fails when the page budget is
+    // used up and every sprite of that size was already drawn in this paint;
+    // the caller then draws directly.
+    bool allocate(const Key& key, Sprite& out);
+
+    void clear();
+
+private:
+    static constexpr int PAGE_SIZE = 1024;
+    // 4 MB ARGB pages: at most 64 MB per atlas, across every sprite size
+    static constexpr size_t MAX_PAGES = 16;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        int slot;
+        unsigned long long lastPaint;
+        std::list<Key>::iterator order;
+    };
+
+    // All sprites of one pixel size: their pages and LRU order
+    struct SizeClass {
+        QSize size;
+        int slotsPerPage{ 0 };
+        std::vector<std::unique_ptr<QImage>> pages;
+        int usedSlots{ 0 };
+        unsigned long long lastPaint{ 0 };
+        std::list<Key> lru;  // most recently used first
+        std::unordered_map<Key, Entry, KeyHash> entries;
+
+        Sprite spriteAt(int slot) const;
+    };
+
+    SizeClass& sizeClassFor(const QSize& size);
+    // Drops the least recently drawn size other than 'keep' that was not
+    // drawn in this paint; false if there is none.
+    bool releaseStaleClass(const SizeClass& keep);
+    static void clearSlot(const Sprite& sprite);
+
+    double rasterScale{ 0 };
+    int radius{ 0 };
+    QFont labelFont;
+    unsigned long long paintStamp{ 0 };
+    size_t pageCount{ 0 };
+    std::map<std::pair<int, int>, SizeClass> classes;
+};
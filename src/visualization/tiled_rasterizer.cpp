@@ -0,0 +1,70 @@
+#include "tiled_rasterizer.h"
+#include <QPainter>
+#include <QRunnable>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+class TileTask : public QRunnable {
+public:
+    explicit TileTask(std::function<void()> work) : work(std::move(work)) {}
+    void run() override { work(); }
+
+private:
+    std::function<void()> work;
+};
+
+int floorToTile(int value, int tile) {
+    return static_cast<int>(std::floor(static_cast<double>(value) / tile)) * tile;
+}
+
+} // namespace
+
+TiledRasterizer::TiledRasterizer(const RenderList& list, int nodeRadius)
+    : renderList(list) {
+    const int threads = std::max(1, QThread::idealThreadCount());
+    pool.setMaxThreadCount(threads);
+    for (int i = 0; i < threads; ++i) {
+        auto painter = std::make_unique<FramePainter>(renderList, nodeRadius);
+        painter->setStaticText(false);
+        painters.push_back(std::move(painter));
+    }
+}
+
+void TiledRasterizer::render(QPainter& p, const QTransform& camera, const QRect& area, double zoom, double ratio) {
+    // Tiles sit on a fixed widget-space grid so their images can be reused
+    size_t count = 0;
+    for (int y = floorToTile(area.top(), TILE_PX); y <= area.bottom(); y += TILE_PX) {
+        for (int x = floorToTile(area.left(), TILE_PX); x <= area.right(); x += TILE_PX) {
+            if (count == tiles.size()) tiles.emplace_back();
+            tiles[count++].rect = QRect(x, y, TILE_PX, TILE_PX).intersected(area);
+        }
+    }
+    if (count == 0) return;
+
+    const int workers = std::min(static_cast<int>(count), workerCount());
+    for (int w = 0; w < workers; ++w) {
+        pool.start(new TileTask([this, w, workers, count, &camera, zoom, ratio]() {
+            for (size_t t = w; t < count; t += workers) renderTile(*painters[w], tiles[t], camera, zoom, ratio);
+        }));
+    }
+    pool.waitForDone();
+
+    for (size_t t = 0; t < count; ++t) p.drawImage(tiles[t].rect.topLeft(), tiles[t].image);
+}
+
+void TiledRasterizer::renderTile(FramePainter& painter, Tile& tile, const QTransform& camera, double zoom, double ratio) const {
+    const QSize pixels(static_cast<int>(std::ceil(tile.rect.width() * ratio)), static_cast<int>(std::ceil(tile.rect.height() * ratio)));
+    if (tile.image.size() != pixels || tile.image.devicePixelRatio() != ratio) {
+        tile.image = QImage(pixels, QImage::Format_ARGB32_Premultiplied);
+        tile.image.setDevicePixelRatio(ratio);
+    }
+
+    // Same camera, shifted so the tile's corner is the image origin
+    QPainter p(&tile.image);
+    const QTransform tileCamera = camera * QTransform::fromTranslate(-tile.rect.x(), -tile.rect.y());
+    painter.paintScene(p, tileCamera, QRect(QPoint(0, 0), tile.rect.size()), zoom);
+}
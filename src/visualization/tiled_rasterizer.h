@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QThreadPool>
+#include <QTransform>
+#include <memory>
+#include <vector>
+#include "frame_painter.h"
+#include "render_list.h"
+
+class QPainter;
+
+/**
+ * @class TiledRasterizer
+ * @brief Renders a scene on a worker pool, one QImage per screen tile.
+ *
+ * The area to paint is cut into square tiles. Each worker owns a
+ * FramePainter and renders every N-th tile with the full scene pipeline,
+ * culled to that tile through the RenderList's spatial index. The tiles
+ * are then composited with the caller's painter. The RenderList is only
+ * read while the workers run, so it must not change during render().
+ */
+class TiledRasterizer {
+public:
+    TiledRasterizer(const RenderList& list, int nodeRadius);
+
+    // Paints 'area' (widget pixels) for 'camera' at the given device pixel ratio
+    void render(QPainter& p, const QTransform& camera, const QRect& area, double zoom, double ratio);
+
+    int workerCount() const { return static_cast<int>(painters.size()); }
+
+private:
+    // Multiple of the dense LOD bucket sizes (3 and 10 px), so buckets line up across tiles
+    static constexpr int TILE_PX = 240;
+
+    struct Tile {
+        QRect rect;    // widget pixels
+        QImage image;  // reused while the tile size and pixel ratio stay the same
+    };
+
+    void renderTile(FramePainter& painter, Tile& tile, const QTransform& camera, double zoom, double ratio) const;
+
+    const RenderList& renderList;
+    QThreadPool pool;
+    std::vector<std::unique_ptr<FramePainter>> painters;
+    std::vector<Tile> tiles;
+};
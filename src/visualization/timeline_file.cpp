@@ -0,0 +1,573 @@
+#include "timeline_file.h"
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+using namespace timeline;
+
+namespace {
+
+// Field bits of a frame block; fields are serialized in this order.
+enum FieldBit : uint32_t {
+    F_OPERATION = 1u << 0,
+    F_HIGHLIGHTED_NODES = 1u << 1,
+    F_HIGHLIGHTED_EDGES = 1u << 2,
+    F_NODE_POSITIONS = 1u << 3,
+    F_NODE_COLORS = 1u << 4,
+    F_EDGE_COLORS = 1u << 5,
+    F_NODE_SHAPES = 1u << 6,
+    F_EDGES = 1u << 7,
+    F_NODE_LABELS = 1u << 8,
+    F_EDGE_LABELS = 1u << 9,
+    F_ANNOTATIONS = 1u << 10,
+    F_DOT_CODE = 1u << 11,
+    F_MERGED_OPERATIONS = 1u << 12 // since 1.1
+};
+
+// Separates the operation types joined into one index string
+constexpr char OPERATION_SEPARATOR = '\x1f';
+
+using StringMap = std::map<std::string, std::string>;
+using PositionMap = std::map<std::string, std::pair<double, double>>;
+using EdgeList = std::vector<std::pair<std::string, std::string>>;
+
+void putU16(QByteArray& out, quint16 v) {
+    char b[2];
+    qToLittleEndian(v, b);
+    out.append(b, 2);
+}
+
+void putU32(QByteArray& out, quint32 v) {
+    char b[4];
+    qToLittleEndian(v, b);
+    out.append(b, 4);
+}
+
+void putU64(QByteArray& out, quint64 v) {
+    char b[8];
+    qToLittleEndian(v, b);
+    out.append(b, 8);
+}
+
+void putF64(QByteArray& out, double v) {
+    quint64 bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    putU64(out, bits);
+}
+
+// Bounds-checked little-endian reader over the mapped file.
+struct Cursor {
+    const uchar* p;
+    const uchar* end;
+    bool ok{true};
+
+    bool need(size_t n) {
+        if (!ok || static_cast<size_t>(end - p) < n) { ok = false; return false; }
+        return true;
+    }
+    quint32 u32() {
+        if (!need(4)) return 0;
+        quint32 v = qFromLittleEndian<quint32>(p);
+        p += 4;
+        return v;
+    }
+    quint64 u64() {
+        if (!need(8)) return 0;
+        quint64 v = qFromLittleEndian<quint64>(p);
+        p += 8;
+        return v;
+    }
+    double f64() {
+        quint64 bits = u64();
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// TimelineWriter
+// ============================================================================
+
+TimelineWriter::TimelineWriter(uint32_t interval)
+    : keyframeInterval(interval == 0 ? DEFAULT_KEYFRAME_INTERVAL : interval) {
+    header.keyframeInterval = keyframeInterval;
+}
+
+TimelineWriter::~TimelineWriter() {
+    // After a failed write isOpen is already false: the partial file is gone
+    if (isOpen) finish();
+}
+
+bool TimelineWriter::fail(const QString& message) {
+    error = message;
+    qDebug() << "TimelineWriter:" << message;
+    return false;
+}
+
+bool TimelineWriter::abort(const QString& message) {
+    // A short write leaves writeOffset out of step with the file; any index
+    // written now would point at the wrong bytes, so drop the file instead
+    isOpen = false;
+    failed = true;
+    file.close();
+    file.remove();
+    return fail(message);
+}
+
+bool TimelineWriter::open(const QString& path) {
+    file.setFileName(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return fail("Cannot open " + path + " for writing: " + file.errorString());
+    }
+
+    // Reserve space for the header; it is rewritten by finish()
+    QByteArray placeholder(static_cast<int>(HEADER_SIZE), '\0');
+    if (file.write(placeholder) != placeholder.size()) {
+        return abort("Failed to write timeline header");
+    }
+
+    writeOffset = HEADER_SIZE;
+    index.clear();
+    stringIds.clear();
+    strings.clear();
+    previous = AnimationFrame();
+    failed = false;
+    isOpen = true;
+    return true;
+}
+
+uint32_t TimelineWriter::intern(const std::string& s) {
+    auto it = stringIds.find(s);
+    if (it != stringIds.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.push_back(s);
+    stringIds.emplace(s, id);
+    return id;
+}
+
+void TimelineWriter::encodeFrame(QByteArray& out, const AnimationFrame& frame, bool keyframe) {
+    static const AnimationFrame blank;
+    const AnimationFrame& base = keyframe ? blank : previous;
+
+    uint32_t mask = 0;
+    if (frame.operationType != base.operationType) mask |= F_OPERATION;
+    if (frame.highlightedNodes != base.highlightedNodes) mask |= F_HIGHLIGHTED_NODES;
+    if (frame.highlightedEdges != base.highlightedEdges) mask |= F_HIGHLIGHTED_EDGES;
+    if (frame.nodePositions != base.nodePositions) mask |= F_NODE_POSITIONS;
+    if (frame.nodeColors != base.nodeColors) mask |= F_NODE_COLORS;
+    if (frame.edgeColors != base.edgeColors) mask |= F_EDGE_COLORS;
+    if (frame.nodeShapes != base.nodeShapes) mask |= F_NODE_SHAPES;
+    if (frame.edges != base.edges) mask |= F_EDGES;
+    if (frame.nodeLabels != base.nodeLabels) mask |= F_NODE_LABELS;
+    if (frame.edgeLabels != base.edgeLabels) mask |= F_EDGE_LABELS;
+    if (frame.annotations != base.annotations) mask |= F_ANNOTATIONS;
+    if (frame.dotCode != base.dotCode) mask |= F_DOT_CODE;
+    if (frame.mergedOperations != base.mergedOperations) mask |= F_MERGED_OPERATIONS;
+
+    putU32(out, mask);
+    putU32(out, static_cast<quint32>(frame.frameNumber));
+    putU32(out, static_cast<quint32>(frame.duration));
+    putU64(out, static_cast<quint64>(frame.timestamp));
+
+    auto putStrings = [&](const std::vector<std::string>& list) {
+        putU32(out, static_cast<quint32>(list.size()));
+        for (const auto& s : list) putU32(out, intern(s));
+    };
+    // Annotations are stored as their formatted text so recordings stay
+    // readable even if the template table changes.
+    auto putAnnotations = [&](const std::vector<FrameAnnotation>& list) {
+        putU32(out, static_cast<quint32>(list.size()));
+        for (const auto& a : list) putU32(out, intern(a.format()));
+    };
+    auto putEdges = [&](const EdgeList& list) {
+        putU32(out, static_cast<quint32>(list.size()));
+        for (const auto& e : list) {
+            putU32(out, intern(e.first));
+            putU32(out, intern(e.second));
+        }
+    };
+    // Map fields are written as the entries set since 'before' followed by
+    // the keys erased since 'before'.
+    auto putStringMap = [&](const StringMap& before, const StringMap& after) {
+        std::vector<const StringMap::value_type*> sets;
+        for (const auto& kv : after) {
+            auto it = before.find(kv.first);
+            if (it == before.end() || it->second != kv.second) sets.push_back(&kv);
+        }
+        putU32(out, static_cast<quint32>(sets.size()));
+        for (const auto* kv : sets) {
+            putU32(out, intern(kv->first));
+            putU32(out, intern(kv->second));
+        }
+        std::vector<uint32_t> erased;
+        for (const auto& kv : before) {
+            if (!after.count(kv.first)) erased.push_back(intern(kv.first));
+        }
+        putU32(out, static_cast<quint32>(erased.size()));
+        for (uint32_t id : erased) putU32(out, id);
+    };
+    auto putPositionMap = [&](const PositionMap& before, const PositionMap& after) {
+        std::vector<const PositionMap::value_type*> sets;
+        for (const auto& kv : after) {
+            auto it = before.find(kv.first);
+            if (it == before.end() || it->second != kv.second) sets.push_back(&kv);
+        }
+        putU32(out, static_cast<quint32>(sets.size()));
+        for (const auto* kv : sets) {
+            putU32(out, intern(kv->first));
+            putF64(out, kv->second.first);
+            putF64(out, kv->second.second);
+        }
+        std::vector<uint32_t> erased;
+        for (const auto& kv : before) {
+            if (!after.count(kv.first)) erased.push_back(intern(kv.first));
+        }
+        putU32(out, static_cast<quint32>(erased.size()));
+        for (uint32_t id : erased) putU32(out, id);
+    };
+
+    if (mask & F_OPERATION) putU32(out, intern(frame.operationType));
+    if (mask & F_HIGHLIGHTED_NODES) putStrings(frame.highlightedNodes);
+    if (mask & F_HIGHLIGHTED_EDGES) putEdges(frame.highlightedEdges);
+    if (mask & F_NODE_POSITIONS) putPositionMap(base.nodePositions, frame.nodePositions);
+    if (mask & F_NODE_COLORS) putStringMap(base.nodeColors, frame.nodeColors);
+    if (mask & F_EDGE_COLORS) putStringMap(base.edgeColors, frame.edgeColors);
+    if (mask & F_NODE_SHAPES) putStringMap(base.nodeShapes, frame.nodeShapes);
+    if (mask & F_EDGES) putEdges(frame.edges);
+    if (mask & F_NODE_LABELS) putStringMap(base.nodeLabels.toMap(), frame.nodeLabels.toMap());
+    if (mask & F_EDGE_LABELS) putStringMap(base.edgeLabels, frame.edgeLabels);
+    if (mask & F_ANNOTATIONS) putAnnotations(frame.annotations);
+    if (mask & F_DOT_CODE) putU32(out, intern(frame.dotCode));
+    if (mask & F_MERGED_OPERATIONS) putStrings(frame.mergedOperations);
+}
+
+bool TimelineWriter::append(const AnimationFrame& frame) {
+    if (failed) return fail("Timeline writing already failed: " + error);
+    if (!isOpen) return fail("Timeline is not open");
+
+    bool keyframe = (index.size() % keyframeInterval) == 0;
+    QByteArray block;
+    encodeFrame(block, frame, keyframe);
+
+    if (file.write(block) != block.size()) {
+        return abort("Failed to write frame block: " + file.errorString());
+    }
+
+    TimelineIndexEntry entry;
+    entry.offset = writeOffset;
+    entry.size = static_cast<uint32_t>(block.size());
+    // Merged frames list every operation type so seeking finds them under each
+    std::string types = frame.operationType;
+    for (const auto& type : frame.mergedOperations) types += OPERATION_SEPARATOR + type;
+    entry.operationType = intern(types);
+    entry.flags = keyframe ? FLAG_KEYFRAME : 0;
+    entry.duration = frame.duration;
+    index.push_back(entry);
+
+    writeOffset += static_cast<uint64_t>(block.size());
+    previous = frame;
+    return true;
+}
+
+bool TimelineWriter::finish() {
+    if (!isOpen) return false;
+    isOpen = false;
+
+    // Frame index
+    header.frameCount = static_cast<uint32_t>(index.size());
+    header.indexOffset = writeOffset;
+    QByteArray indexBytes;
+    indexBytes.reserve(static_cast<int>(index.size() * INDEX_ENTRY_SIZE));
+    for (const auto& e : index) {
+        putU64(indexBytes, e.offset);
+        putU32(indexBytes, e.size);
+        putU32(indexBytes, e.operationType);
+        putU32(indexBytes, e.flags);
+        putU32(indexBytes, static_cast<quint32>(e.duration));
+    }
+    if (file.write(indexBytes) != indexBytes.size()) {
+        return abort("Failed to write frame index");
+    }
+    writeOffset += static_cast<uint64_t>(indexBytes.size());
+
+    // String table: (offset, length) pairs, then the concatenated bytes
+    header.stringCount = static_cast<uint32_t>(strings.size());
+    header.stringTableOffset = writeOffset;
+    QByteArray table;
+    QByteArray data;
+    for (const auto& s : strings) {
+        putU32(table, static_cast<quint32>(data.size()));
+        putU32(table, static_cast<quint32>(s.size()));
+        data.append(s.data(), static_cast<int>(s.size()));
+    }
+    if (file.write(table) != table.size() || file.write(data) != data.size()) {
+        return abort("Failed to write string table");
+    }
+
+    // Header, now that every offset is known
+    QByteArray head;
+    head.append(MAGIC, 4);
+    putU16(head, header.versionMajor);
+    putU16(head, header.versionMinor);
+    putU32(head, header.frameCount);
+    putU32(head, header.keyframeInterval);
+    putU32(head, header.stringCount);
+    putU32(head, 0);
+    putU64(head, header.blocksOffset);
+    putU64(head, header.indexOffset);
+    putU64(head, header.stringTableOffset);
+    head.append(QByteArray(static_cast<int>(HEADER_SIZE - head.size()), '\0'));
+
+    if (!file.seek(0) || file.write(head) != head.size()) {
+        return abort("Failed to write timeline header");
+    }
+
+    file.close();
+    qDebug() << "TimelineWriter: Wrote" << header.frameCount << "frames,"
+             << header.stringCount << "strings";
+    return true;
+}
+
+// ============================================================================
+// TimelineReader
+// ============================================================================
+
+TimelineReader::~TimelineReader() {
+    close();
+}
+
+bool TimelineReader::fail(const QString& message) {
+    error = message;
+    qDebug() << "TimelineReader:" << message;
+    close();
+    return false;
+}
+
+bool TimelineReader::open(const QString& path) {
+    close();
+    error.clear();
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail("Cannot open " + path + ": " + file.errorString());
+    }
+    mappedSize = file.size();
+    if (mappedSize < static_cast<qint64>(HEADER_SIZE)) {
+        return fail("File is too small to be a timeline");
+    }
+
+    base = file.map(0, mappedSize);
+    if (!base) {
+        return fail("Cannot map " + path + ": " + file.errorString());
+    }
+
+    if (std::memcmp(base, MAGIC, 4) != 0) {
+        return fail("Not a timeline file (bad magic)");
+    }
+
+    header.versionMajor = qFromLittleEndian<quint16>(base + 4);
+    header.versionMinor = qFromLittleEndian<quint16>(base + 6);
+    header.frameCount = qFromLittleEndian<quint32>(base + 8);
+    header.keyframeInterval = qFromLittleEndian<quint32>(base + 12);
+    header.stringCount = qFromLittleEndian<quint32>(base + 16);
+    header.blocksOffset = qFromLittleEndian<quint64>(base + 24);
+    header.indexOffset = qFromLittleEndian<quint64>(base + 32);
+    header.stringTableOffset = qFromLittleEndian<quint64>(base + 40);
+
+    if (header.versionMajor != VERSION_MAJOR) {
+        return fail(QString("Unsupported timeline version %1.%2")
+            .arg(header.versionMajor).arg(header.versionMinor));
+    }
+
+    const uint64_t size = static_cast<uint64_t>(mappedSize);
+    const uint64_t indexBytes = static_cast<uint64_t>(header.frameCount) * INDEX_ENTRY_SIZE;
+    const uint64_t tableBytes = static_cast<uint64_t>(header.stringCount) * 8;
+    if (header.keyframeInterval == 0 ||
+        header.indexOffset > size || indexBytes > size - header.indexOffset ||
+        header.stringTableOffset > size || tableBytes > size - header.stringTableOffset) {
+        return fail("Corrupted timeline header");
+    }
+
+    qDebug() << "TimelineReader: Mapped" << path << "with" << header.frameCount << "frames";
+    return true;
+}
+
+void TimelineReader::close() {
+    if (base) {
+        file.unmap(base);
+        base = nullptr;
+    }
+    if (file.isOpen()) file.close();
+    mappedSize = 0;
+    header = TimelineHeader();
+    cachedIndex = -1;
+    cachedFrame = AnimationFrame();
+}
+
+TimelineIndexEntry TimelineReader::indexEntry(int i) const {
+    TimelineIndexEntry e;
+    const uchar* p = base + header.indexOffset + static_cast<uint64_t>(i) * INDEX_ENTRY_SIZE;
+    e.offset = qFromLittleEndian<quint64>(p);
+    e.size = qFromLittleEndian<quint32>(p + 8);
+    e.operationType = qFromLittleEndian<quint32>(p + 12);
+    e.flags = qFromLittleEndian<quint32>(p + 16);
+    e.duration = static_cast<int32_t>(qFromLittleEndian<quint32>(p + 20));
+    return e;
+}
+
+std::string TimelineReader::stringAt(uint32_t id) const {
+    if (!base || id >= header.stringCount) return std::string();
+    const uchar* entry = base + header.stringTableOffset + static_cast<uint64_t>(id) * 8;
+    uint64_t dataStart = header.stringTableOffset + static_cast<uint64_t>(header.stringCount) * 8;
+    uint64_t offset = dataStart + qFromLittleEndian<quint32>(entry);
+    uint32_t length = qFromLittleEndian<quint32>(entry + 4);
+    if (offset > static_cast<uint64_t>(mappedSize) || length > static_cast<uint64_t>(mappedSize) - offset) {
+        return std::string();
+    }
+    return std::string(reinterpret_cast<const char*>(base + offset), length);
+}
+
+std::vector<std::string> TimelineReader::operationTypesAt(int i) const {
+    std::vector<std::string> types;
+    if (!base || i < 0 || i >= frameCount()) return types;
+    const std::string joined = stringAt(indexEntry(i).operationType);
+    size_t start = 0;
+    for (;;) {
+        size_t end = joined.find(OPERATION_SEPARATOR, start);
+        types.push_back(joined.substr(start, end - start));
+        if (end == std::string::npos) break;
+        start = end + 1;
+    }
+    return types;
+}
+
+int TimelineReader::durationAt(int i) const {
+    if (!base || i < 0 || i >= frameCount()) return 0;
+    return indexEntry(i).duration;
+}
+
+bool TimelineReader::decodeBlock(int i, AnimationFrame& frame) const {
+    TimelineIndexEntry e = indexEntry(i);
+    if (e.offset > static_cast<uint64_t>(mappedSize) || e.size > static_cast<uint64_t>(mappedSize) - e.offset) {
+        return false;
+    }
+
+    if (e.flags & FLAG_KEYFRAME) frame = AnimationFrame();
+
+    Cursor c{ base + e.offset, base + e.offset + e.size };
+    uint32_t mask = c.u32();
+    frame.frameNumber = static_cast<int>(c.u32());
+    frame.duration = static_cast<int>(c.u32());
+    frame.timestamp = static_cast<long long>(c.u64());
+
+    auto readStrings = [&](std::vector<std::string>& list) {
+        uint32_t n = c.u32();
+        if (!c.need(static_cast<size_t>(n) * 4)) return;
+        list.clear();
+        list.reserve(n);
+        for (uint32_t k = 0; k < n; ++k) list.push_back(stringAt(c.u32()));
+    };
+    auto readAnnotations = [&](std::vector<FrameAnnotation>& list) {
+        uint32_t n = c.u32();
+        if (!c.need(static_cast<size_t>(n) * 4)) return;
+        list.clear();
+        list.reserve(n);
+        for (uint32_t k = 0; k < n; ++k) list.emplace_back(stringAt(c.u32()));
+    };
+    auto readEdges = [&](EdgeList& list) {
+        uint32_t n = c.u32();
+        if (!c.need(static_cast<size_t>(n) * 8)) return;
+        list.clear();
+        list.reserve(n);
+        for (uint32_t k = 0; k < n; ++k) {
+            std::string a = stringAt(c.u32());
+            list.emplace_back(std::move(a), stringAt(c.u32()));
+        }
+    };
+    auto readStringMap = [&](StringMap& map) {
+        uint32_t sets = c.u32();
+        if (!c.need(static_cast<size_t>(sets) * 8)) return;
+        for (uint32_t k = 0; k < sets; ++k) {
+            std::string key = stringAt(c.u32());
+            map[key] = stringAt(c.u32());
+        }
+        uint32_t erased = c.u32();
+        if (!c.need(static_cast<size_t>(erased) * 4)) return;
+        for (uint32_t k = 0; k < erased; ++k) map.erase(stringAt(c.u32()));
+    };
+    // Same encoding as a string map; applying it to the previous frame's
+    // table keeps the shared base and only records the changed slots
+    auto readLabelTable = [&](LabelTable& table) {
+        uint32_t sets = c.u32();
+        if (!c.need(static_cast<size_t>(sets) * 8)) return;
+        for (uint32_t k = 0; k < sets; ++k) {
+            std::string key = stringAt(c.u32());
+            table.set(key, stringAt(c.u32()));
+        }
+        uint32_t erased = c.u32();
+        if (!c.need(static_cast<size_t>(erased) * 4)) return;
+        for (uint32_t k = 0; k < erased; ++k) table.erase(stringAt(c.u32()));
+    };
+    auto readPositionMap = [&](PositionMap& map) {
+        uint32_t sets = c.u32();
+        if (!c.need(static_cast<size_t>(sets) * 20)) return;
+        for (uint32_t k = 0; k < sets; ++k) {
+            std::string key = stringAt(c.u32());
+            double x = c.f64();
+            double y = c.f64();
+            map[key] = { x, y };
+        }
+        uint32_t erased = c.u32();
+        if (!c.need(static_cast<size_t>(erased) * 4)) return;
+        for (uint32_t k = 0; k < erased; ++k) map.erase(stringAt(c.u32()));
+    };
+
+    if (mask & F_OPERATION) frame.operationType = stringAt(c.u32());
+    if (mask & F_HIGHLIGHTED_NODES) readStrings(frame.highlightedNodes);
+    if (mask & F_HIGHLIGHTED_EDGES) readEdges(frame.highlightedEdges);
+    if (mask & F_NODE_POSITIONS) readPositionMap(frame.nodePositions);
+    if (mask & F_NODE_COLORS) readStringMap(frame.nodeColors);
+    if (mask & F_EDGE_COLORS) readStringMap(frame.edgeColors);
+    if (mask & F_NODE_SHAPES) readStringMap(frame.nodeShapes);
+    if (mask & F_EDGES) readEdges(frame.edges);
+    if (mask & F_NODE_LABELS) readLabelTable(frame.nodeLabels);
+    if (mask & F_EDGE_LABELS) readStringMap(frame.edgeLabels);
+    if (mask & F_ANNOTATIONS) readAnnotations(frame.annotations);
+    if (mask & F_DOT_CODE) frame.dotCode = stringAt(c.u32());
+    if (mask & F_MERGED_OPERATIONS) readStrings(frame.mergedOperations);
+
+    return c.ok;
+}
+
+AnimationFrame TimelineReader::frameAt(int i) {
+    if (!base || i < 0 || i >= frameCount()) return AnimationFrame();
+    if (i == cachedIndex) return cachedFrame;
+
+    // Find the nearest keyframe at or before i
+    int interval = keyframeInterval();
+    int key = i - (i % interval);
+    while (key > 0 && !(indexEntry(key).flags & FLAG_KEYFRAME)) --key;
+
+    // Continue from the cached frame when it lies between the keyframe and i
+    int start = key;
+    AnimationFrame frame;
+    if (cachedIndex >= key && cachedIndex < i) {
+        start = cachedIndex + 1;
+        frame = cachedFrame;
+    }
+
+    for (int k = start; k <= i; ++k) {
+        if (!decodeBlock(k, frame)) {
+            qDebug() << "TimelineReader: Corrupted frame block" << k;
+            cachedIndex = -1;
+            return AnimationFrame();
+        }
+    }
+
+    cachedIndex = i;
+    cachedFrame = frame;
+    return frame;
+}
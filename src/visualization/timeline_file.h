@@ -0,0 +1,148 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "animation_frame.h"
+
+/**
+ * On-disk layout of a recorded timeline (".dvtl"), all integers little-endian:
+ *
+ *   [Header        ] fixed 64 bytes, see TimelineHeader
+ *   [Frame blocks  ] one block per frame, keyframes every N frames, deltas otherwise
+ *   [Frame index   ] frameCount x TimelineIndexEntry (offset/size/type of each block)
+ *   [String table  ] stringCount x (offset, length) followed by the UTF-8 bytes
+ *
+ * Every string (node ids, colors, labels, annotations...) is stored once in
+ * the string table and referenced by a 32-bit id from the frame blocks.
+ * A keyframe block describes the full frame; a delta block only carries the
+ * fields that changed since the previous frame (map fields as set/erase lists).
+ */
+namespace timeline {
+
+constexpr char MAGIC[4] = { 'D', 'V', 'T', 'L' };
+constexpr uint16_t VERSION_MAJOR = 1;
+constexpr uint16_t VERSION_MINOR = 1;
+constexpr uint32_t HEADER_SIZE = 64;
+constexpr uint32_t INDEX_ENTRY_SIZE = 24;
+constexpr uint32_t DEFAULT_KEYFRAME_INTERVAL = 64;
+
+// Index entry flags
+constexpr uint32_t FLAG_KEYFRAME = 0x1;
+
+struct TimelineHeader {
+    uint16_t versionMajor = VERSION_MAJOR;
+    uint16_t versionMinor = VERSION_MINOR;
+    uint32_t frameCount = 0;
+    uint32_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+    uint32_t stringCount = 0;
+    uint64_t blocksOffset = HEADER_SIZE;
+    uint64_t indexOffset = 0;
+    uint64_t stringTableOffset = 0;
+};
+
+struct TimelineIndexEntry {
+    uint64_t offset = 0;     // absolute file offset of the frame block
+    uint32_t size = 0;       // block size in bytes
+    uint32_t operationType = 0; // string id, lets seeking filter without decoding;
+                                // since 1.1 merged types are joined with '\x1f'
+    uint32_t flags = 0;
+    int32_t duration = 0;
+};
+
+} // namespace timeline
+
+/**
+ * @class TimelineWriter
+ * @brief Streams AnimationFrame objects into a versioned binary timeline file.
+ *
+ * Frames are encoded as they are appended so a recording never has to be
+ * held in memory twice; the index and string table are written by finish().
+ * If any write fails the partial file is removed rather than finished.
+ */
+class TimelineWriter {
+public:
+    explicit TimelineWriter(uint32_t keyframeInterval = timeline::DEFAULT_KEYFRAME_INTERVAL);
+    ~TimelineWriter();
+
+    bool open(const QString& path);
+    bool append(const AnimationFrame& frame);
+    bool finish();
+
+    QString errorString() const { return error; }
+
+private:
+    uint32_t intern(const std::string& s);
+    void encodeFrame(QByteArray& out, const AnimationFrame& frame, bool keyframe);
+    bool fail(const QString& message);
+    // Fails for good: closes and removes the partly written file
+    bool abort(const QString& message);
+
+    QFile file;
+    QString error;
+    uint32_t keyframeInterval;
+    timeline::TimelineHeader header;
+    std::vector<timeline::TimelineIndexEntry> index;
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::vector<std::string> strings;
+    AnimationFrame previous;
+    uint64_t writeOffset{0};
+    bool isOpen{false};
+    bool failed{false};    // a write failed; finish() must not index the file
+};
+
+/**
+ * @class TimelineReader
+ * @brief Read-only, memory-mapped access to a recorded timeline file.
+ *
+ * The file is mapped once with QFile::map; decoding a frame only touches the
+ * pages of its nearest keyframe and the deltas that follow it, so scrubbing a
+ * very large recording never loads it into RAM. The last decoded frame is
+ * cached so sequential playback decodes one delta per step.
+ */
+class TimelineReader {
+public:
+    TimelineReader() = default;
+    ~TimelineReader();
+
+    TimelineReader(const TimelineReader&) = delete;
+    TimelineReader& operator=(const TimelineReader&) = delete;
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    int frameCount() const { return static_cast<int>(header.frameCount); }
+    int keyframeInterval() const { return static_cast<int>(header.keyframeInterval); }
+
+    /**
+     * @brief Decode frame @p index (0-based). Returns an empty frame when out of range.
+     */
+    AnimationFrame frameAt(int index);
+
+    // Index lookups that do not decode the frame block
+    // Operation type of the frame followed by any types merged into it
+    std::vector<std::string> operationTypesAt(int index) const;
+    int durationAt(int index) const;
+
+    QString errorString() const { return error; }
+
+private:
+    bool fail(const QString& message);
+    timeline::TimelineIndexEntry indexEntry(int index) const;
+    std::string stringAt(uint32_t id) const;
+    bool decodeBlock(int index, AnimationFrame& frame) const;
+
+    QFile file;
+    QString error;
+    uchar* base{nullptr};
+    qint64 mappedSize{0};
+    timeline::TimelineHeader header;
+
+    int cachedIndex{-1};
+    AnimationFrame cachedFrame;
+};
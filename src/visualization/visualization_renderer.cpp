@@ -1,18 +1,77 @@
 ﻿#include "visualization_renderer.h"
 #include <QPainter>
+#include <QPaintEvent>
+#include <QRegion>
 #include <cmath>
-#include <regex> // Used to extract numeric index from IDs like "arr_5"
+#include <algorithm>
 
 VisualizationRenderer::VisualizationRenderer(QWidget* parent)
  : QWidget(parent) {
  setMinimumSize(600,400);
  setBackgroundRole(QPalette::Base);
  setAutoFillBackground(true);
+
+ transitionTimer = new QTimer(this);
+ transitionTimer->setTimerType(Qt::PreciseTimer);
+ transitionTimer->setInterval(TRANSITION_TICK_MS);
+ connect(transitionTimer, &QTimer::timeout, this, &VisualizationRenderer::onTransitionTick);
+
+ gestureTimer = new QTimer(this);
+ gestureTimer->setSingleShot(true);
+ gestureTimer->setInterval(GESTURE_IDLE_MS);
+ connect(gestureTimer, &QTimer::timeout, this, [this]() {
+ viewGesture = false;
+ update();
+ });
 }
 
 void VisualizationRenderer::renderFrame(const AnimationFrame& frame) {
+ transitionTimer->stop();
+ interpolator.clear();
  currentFrame = frame;
- update();
+ compileFrame();
+ invalidateChanged();
+}
+
+void VisualizationRenderer::animateToFrame(const AnimationFrame& frame) {
+ // An interrupted tween continues from whatever is on screen now
+ transitionTimer->stop();
+ interpolator.prepare(currentFrame, frame);
+
+ if (transitionMs <=0 || !interpolator.hasChanges()) {
+ renderFrame(frame);
+ return;
+ }
+
+ // Labels, highlights and edges switch now; tracked nodes start from the old values
+ currentFrame = frame;
+ interpolator.apply(currentFrame,0.0);
+ compileFrame();
+ transitionClock.start();
+ transitionTimer->start();
+ invalidateChanged();
+}
+
+void VisualizationRenderer::compileFrame() {
+ // Array glyphs are laid out once per font
+ renderList.setBaseFont(font());
+ renderList.compile(currentFrame, baseNodeRadius);
+}
+
+void VisualizationRenderer::setTransitionDuration(int ms) {
+ transitionMs = std::max(0, ms);
+}
+
+void VisualizationRenderer::onTransitionTick() {
+ double t = transitionMs >0 ? static_cast<double>(transitionClock.elapsed()) / transitionMs : 1.0;
+ if (t >= 1.0) {
+ transitionTimer->stop();
+ t = 1.0;
+ }
+ interpolator.apply(currentFrame, t);
+ // Only the tweened nodes (and their edges) are recompiled
+ for (const auto& id : interpolator.changedNodeIds()) renderList.refreshNode(currentFrame, id);
+ invalidateChanged();
 }
 
 void VisualizationRenderer::renderVisualization(const QString& dot) {
@@ -22,7 +81,7 @@ void VisualizationRenderer::renderVisualization(const QString& dot) {
 
 void VisualizationRenderer::setZoomFactor(float scale) {
  zoomLevel = scale;
- update();
+ beginViewGesture();
 }
 
 void VisualizationRenderer::setNodeRadius(int radius) {
@@ -32,236 +91,175 @@ void VisualizationRenderer::setNodeRadius(int radius) {
 
 void VisualizationRenderer::panBy(double dx, double dy) {
  panOffset += QPointF(dx, dy);
- update();
+ beginViewGesture();
 }
 
 void VisualizationRenderer::setPanOffset(const QPointF& offset) {
  panOffset = offset;
- update();
+ beginViewGesture();
 }
 
-void VisualizationRenderer::paintEvent(QPaintEvent*) {
- QPainter p(this);
- p.setRenderHint(QPainter::Antialiasing);
-
- //1. Background: clear canvas to white
- p.fillRect(rect(), Qt::white);
-
- p.save();
+void VisualizationRenderer::setTiledRendering(bool enabled) {
+ tiledForced = enabled;
+ sceneCacheValid = false;
+ update();
+}
 
- //2. Camera transform and grid
- // - Center the scene, apply zoom, then pan offset.
- p.translate(width() /2.0, height() /2.0);
- p.scale(zoomLevel, zoomLevel);
- p.translate(-width() /2.0 + panOffset.x(), -height() /2.0 + panOffset.y());
+void VisualizationRenderer::centerOn(const QPointF& scenePos) {
+ // The camera zooms around the widget center, so only the pan moves the point there
+ setPanOffset(QPointF(width() /2.0, height() /2.0) - scenePos);
+}
 
- // Draw a subtle grid to help positioning
- double visibleW = width() / zoomLevel;
- double visibleH = height() / zoomLevel;
- double startX = -visibleW *2;
- double startY = -visibleH *2;
- double endX = visibleW *2;
- double endY = visibleH *2;
+QRectF VisualizationRenderer::visibleSceneRect() const {
+ return cameraTransform().inverted().mapRect(QRectF(rect()));
+}
 
- QPen gridPen(QColor("#F0F0F0"),1, Qt::SolidLine);
- gridPen.setCosmetic(true);
- p.setPen(gridPen);
+void VisualizationRenderer::beginViewGesture() {
+ viewGesture = true;
+ gestureTimer->start();
+ update();
+ emit viewChanged();
+}
 
- int gridSize =50;
+bool VisualizationRenderer::LayerCache::isCurrent(const QTransform& t, const QSize& s, double ratio, unsigned long long v) const {
+ return !pixmap.isNull() && camera == t && size == s && pixelRatio == ratio && version == v;
+}
 
- for (double i = startX; i < endX; i += gridSize) {
- double x = std::floor(i / gridSize) * gridSize;
- p.drawLine(QPointF(x, startY), QPointF(x, endY));
- }
- for (double i = startY; i < endY; i += gridSize) {
- double y = std::floor(i / gridSize) * gridSize;
- p.drawLine(QPointF(startX, y), QPointF(endX, y));
+void VisualizationRenderer::LayerCache::reset(const QTransform& t, const QSize& s, double ratio, unsigned long long v) {
+ if (pixmap.isNull() || size != s || pixelRatio != ratio) {
+ pixmap = QPixmap(static_cast<int>(std::ceil(s.width() * ratio)), static_cast<int>(std::ceil(s.height() * ratio)));
+ pixmap.setDevicePixelRatio(ratio);
  }
+ camera = t;
+ size = s;
+ pixelRatio = ratio;
+ version = v;
+}
 
- int r = baseNodeRadius;
+void VisualizationRenderer::paintGridLayer(const QTransform& camera, const QRectF& viewport) {
+ const double ratio = devicePixelRatioF();
+ if (gridLayer.isCurrent(camera, size(), ratio,0)) return;
+ gridLayer.reset(camera, size(), ratio,0);
 
- //3. Draw edges
- p.setPen(QPen(Qt::black,2));
+ // Background: clear canvas to white
+ gridLayer.pixmap.fill(Qt::white);
+ QPainter p(&gridLayer.pixmap);
+ p.setTransform(camera);
+ framePainter.paintGrid(p, viewport);
+}
 
- for (const auto& edge : currentFrame.edges) {
- std::string src = edge.first;
- std::string dst = edge.second;
+void VisualizationRenderer::paintEdgeLayer(const QTransform& camera, const QRectF& viewport, bool full) {
+ const double ratio = devicePixelRatioF();
+ // Geometry version plus the detail tier, which changes pen and antialiasing
+ const unsigned long long version = renderList.edgeGeometryVersion() *2 + (full ?1 :0);
+ if (edgeLayer.isCurrent(camera, size(), ratio, version)) return;
+ edgeLayer.reset(camera, size(), ratio, version);
+
+ edgeLayer.pixmap.fill(Qt::transparent);
+ QPainter p(&edgeLayer.pixmap);
+ p.setTransform(camera);
+ framePainter.paintEdges(p, viewport, full);
+}
 
- if (currentFrame.nodePositions.count(src) && currentFrame.nodePositions.count(dst)) {
- auto p1 = currentFrame.nodePositions.at(src);
- auto p2 = currentFrame.nodePositions.at(dst);
+QTransform VisualizationRenderer::cameraTransform() const {
+ return FramePainter::camera(QSizeF(size()), zoomLevel, panOffset);
+}
 
- std::string type1 = "CIRCLE";
- if (currentFrame.nodeShapes.count(src)) type1 = currentFrame.nodeShapes.at(src);
+void VisualizationRenderer::invalidateChanged() {
+ // Moved edges, the dense LOD tiers (clusters shift with any node),
+ // large change sets and active gestures repaint everything; otherwise
+ // only the changed nodes
+ sceneDirty = true;
+ emit sceneChanged();
+ const bool dense = FramePainter::isDense(FramePainter::detailLevelFor(2.0 * baseNodeRadius * zoomLevel));
+ if (viewGesture || dense || renderList.dirtyOverflow() || renderList.edgeGeometryVersion() != invalidatedEdgeVersion) {
+ invalidatedEdgeVersion = renderList.edgeGeometryVersion();
+ renderList.clearDirty();
+ update();
+ return;
+ }
 
- // Do not draw edges for arrays (arrays are drawn as contiguous boxes)
- if (type1 != "ARRAY") {
- QPointF startPoint(p1.first, p1.second);
- QPointF endPoint(p2.first, p2.second);
+ const QTransform camera = cameraTransform();
+ QRegion region;
+ for (const QRectF& bounds : renderList.dirtyRects()) {
+ // A couple of pixels of slack for antialiasing
+ region |= camera.mapRect(bounds).toAlignedRect().adjusted(-2, -2,2,2);
+ }
+ renderList.clearDirty();
+ if (!region.isEmpty()) update(region);
+}
 
- if (type1 == "RECT") {
- // List: draw a line and arrowhead between list nodes
- float w = r *3.0f;
- startPoint.setX(startPoint.x() + w /2 -10);
- if (endPoint.x() > startPoint.x()) endPoint.setX(endPoint.x() - w /2);
- p.drawLine(startPoint, endPoint);
+void VisualizationRenderer::paintEvent(QPaintEvent* event) {
+ const QTransform camera = cameraTransform();
+ const double ratio = devicePixelRatioF();
+ const QSize cacheSize(static_cast<int>(std::ceil(width() * ratio)), static_cast<int>(std::ceil(height() * ratio)));
+ const bool cacheFits = sceneCacheValid && sceneCache.size() == cacheSize && sceneCache.devicePixelRatio() == ratio;
 
- p.setBrush(Qt::black);
- QPolygonF arrow;
- arrow << endPoint << QPointF(endPoint.x() -8, endPoint.y() -4) << QPointF(endPoint.x() -8, endPoint.y() +4);
- p.drawPolygon(arrow);
- }
- else {
- // Circle: draw a line between circle edges (accounts for radius)
- double dx = p2.first - p1.first;
- double dy = p2.second - p1.second;
- double len = std::sqrt(dx * dx + dy * dy);
- if (len >0) {
- double uX = dx / len;
- double uY = dy / len;
- QPointF s(p1.first + uX * r, p1.second + uY * r);
- QPointF e(p2.first - uX * r, p2.second - uY * r);
- p.drawLine(s, e);
- }
- }
+ // Pan/zoom in progress over an unchanged scene: reproject the last render
+ if (viewGesture && cacheFits && !sceneDirty) {
+ QPainter p(this);
+ p.fillRect(rect(), Qt::white);
+ p.setTransform(sceneCacheCamera.inverted() * camera);
+ p.drawPixmap(0,0, sceneCache);
+ return;
  }
+
+ // Full-quality render into sceneCache, then copy the exposed part. A new
+ // camera or cache size needs the whole widget, whatever was exposed.
+ if (!cacheFits) {
+ sceneCache = QPixmap(cacheSize);
+ sceneCache.setDevicePixelRatio(ratio);
  }
+ const QRect paintRect = cacheFits && sceneCacheCamera == camera ? event->rect() : rect();
+ {
+ QPainter sp(&sceneCache);
+ sp.setClipRect(paintRect);
+ paintScene(sp, camera, paintRect);
  }
+ sceneCacheCamera = camera;
+ sceneCacheValid = true;
+ sceneDirty = false;
 
- //4. Draw nodes
- for (const auto& kv : currentFrame.nodePositions) {
- std::string id = kv.first;
- double x = kv.second.first;
- double y = kv.second.second;
-
- std::string type = "CIRCLE";
- if (currentFrame.nodeShapes.count(id)) type = currentFrame.nodeShapes.at(id);
-
- // Determine fill color: prefer explicit per-frame color mapping
- QColor fillColor = QColor("#3498db"); // default blue
- if (currentFrame.nodeColors.count(id)) {
- QString cName = QString::fromStdString(currentFrame.nodeColors.at(id));
- if (QColor::isValidColor(cName)) fillColor = QColor(cName);
- else if (cName == "red") fillColor = QColor("#e74c3c");
- else if (cName == "green") fillColor = QColor("#2ecc71");
- else if (cName == "yellow") fillColor = QColor("#f39c12");
- else if (cName == "orange") fillColor = QColor("#e67e22");
- else if (cName == "blue") fillColor = QColor("#3498db");
- else if (cName == "cyan") fillColor = QColor("#1abc9c");
- else if (cName == "purple") fillColor = QColor("#9b59b6");
- else if (cName == "lightgray") fillColor = QColor("#bdc3c7");
- else if (cName == "#4CAF50") fillColor = QColor("#4CAF50");
- else if (cName == "#FF9800") fillColor = QColor("#FF9800");
- else if (cName == "#9E9E9E") fillColor = QColor("#9E9E9E");
- else if (cName == "#2196F3") fillColor = QColor("#2196F3");
- else if (cName == "#00FF00") fillColor = QColor("#00FF00");
- else if (cName == "#FF6B6B") fillColor = QColor("#FF6B6B");
- }
+ const QRect shown = event->rect();
+ QPainter p(this);
+ p.drawPixmap(QRectF(shown), sceneCache, QRectF(shown.x() * ratio, shown.y() * ratio, shown.width() * ratio, shown.height() * ratio));
+}
 
- if (type == "ARRAY") {
- float size =50.0f; // fixed cell size
- QRectF rect(x - size /2, y - size /2, size, size);
-
- // Slightly lighter background for memory cell look
- QColor memoryColor = (fillColor == QColor("#3498db")) ? QColor("#E3F2FD") : fillColor;
- p.setBrush(memoryColor);
-
- // Dark border for array cell
- p.setPen(QPen(QColor("#2C3E50"),2));
- p.drawRect(rect);
-
- // Draw value centered in the cell
- p.setPen(Qt::black);
- QFont valFont = p.font();
- valFont.setBold(true);
- p.setFont(valFont);
-
- QString textToDraw;
- if (currentFrame.nodeLabels.count(id)) textToDraw = QString::fromStdString(currentFrame.nodeLabels.at(id));
- else textToDraw = QString::fromStdString(id);
- p.drawText(rect, Qt::AlignCenter, textToDraw);
-
- // Draw array index in red below the cell by extracting digits from id (e.g. "arr_5" -> "5")
- std::regex re("(\\d+)");
- std::smatch match;
- if (std::regex_search(id, match, re) && match.size() >1) {
- QString indexStr = QString::fromStdString(match.str(1));
-
- QFont idxFont = p.font();
- idxFont.setPointSize(8);
- idxFont.setBold(false);
- p.setFont(idxFont);
- p.setPen(QColor("#E74C3C")); // red
-
- QRectF idxRect(x - size /2, y + size /2 +2, size,15);
- p.drawText(idxRect, Qt::AlignCenter, indexStr);
+void VisualizationRenderer::paintScene(QPainter& p, const QTransform& camera, const QRect& paintRect) {
+ // Very large scenes: render tiles in parallel, each with the whole pipeline
+ if (tiledForced || renderList.nodes().size() >= TILED_MIN_NODES) {
+ if (!tiledRasterizer) tiledRasterizer = std::make_unique<TiledRasterizer>(renderList, baseNodeRadius);
+ tiledRasterizer->render(p, camera, paintRect, zoomLevel, devicePixelRatioF());
+ return;
  }
 
- // Reset font
- p.setFont(valFont);
- }
- else if (type == "RECT") {
- // List node style: rectangular with a small pointer section
- float w = r *3.0f;
- float h = r *1.5f;
- QRectF rect(x - w /2, y - h /2, w, h);
-
- p.setBrush(fillColor);
- p.setPen(QPen(Qt::black,2));
- p.drawRect(rect);
-
- float barX = x + w /6;
- p.drawLine(barX, y - h /2, barX, y + h /2);
-
- // Draw label/value inside the left portion
- p.setPen(Qt::white);
- QString textToDraw;
- if (currentFrame.nodeLabels.count(id)) textToDraw = QString::fromStdString(currentFrame.nodeLabels.at(id));
- else textToDraw = QString::fromStdString(id);
-
- p.drawText(QRectF(x - w /2, y - h /2, w *0.66, h), Qt::AlignCenter, textToDraw);
- }
- else {
- // Default circle node
- p.setBrush(fillColor);
- p.setPen(QPen(Qt::black,2));
- p.drawEllipse(QPointF(x, y), r, r);
-
- p.setPen(Qt::white);
- QString textToDraw;
- if (currentFrame.nodeLabels.count(id)) textToDraw = QString::fromStdString(currentFrame.nodeLabels.at(id));
- else textToDraw = QString::fromStdString(id);
-
- p.drawText(QRectF(x - r, y - r,2 * r,2 * r), Qt::AlignCenter, textToDraw);
- }
- }
+ // Widget rect in scene coordinates: only what intersects it is drawn.
+ // Nodes are further limited to the exposed part of a partial repaint.
+ const QRectF viewport = camera.inverted().mapRect(QRectF(rect()));
+ const QRectF exposed = camera.inverted().mapRect(QRectF(paintRect));
 
- //5. Highlights: draw an outer glow/outline for highlighted nodes
- p.setPen(QPen(QColor(255,215,0),3)); // gold outline
- p.setBrush(Qt::NoBrush);
-
- for (const auto& id : currentFrame.highlightedNodes) {
- if (currentFrame.nodePositions.count(id)) {
- auto pos = currentFrame.nodePositions.at(id);
- double x = pos.first;
- double y = pos.second;
- std::string type = "CIRCLE";
- if (currentFrame.nodeShapes.count(id)) type = currentFrame.nodeShapes.at(id);
-
- if (type == "ARRAY") {
- float size =50.0f;
- p.drawRect(QRectF(x - size /2 -2, y - size /2 -2, size +4, size +4));
- }
- else if (type == "RECT") {
- float w = r *3.0f +10;
- float h = r *1.5f +10;
- p.drawRect(QRectF(x - w /2, y - h /2, w, h));
- }
- else {
- p.drawEllipse(QPointF(x, y), r +5, r +5);
- }
- }
+ // Level of detail from the on-screen node size
+ const FramePainter::DetailLevel level = FramePainter::detailLevelFor(2.0 * baseNodeRadius * zoomLevel);
+ const bool dense = FramePainter::isDense(level);
+ const bool full = level == FramePainter::DetailLevel::Full;
+
+ //1-3. Background, grid and edges come from cached layers, repainted only
+ // when the camera, the widget size or the edge geometry change
+ paintGridLayer(camera, viewport);
+ if (!dense) paintEdgeLayer(camera, viewport, full);
+
+ p.drawPixmap(0,0, gridLayer.pixmap);
+ if (!dense) p.drawPixmap(0,0, edgeLayer.pixmap);
+
+ p.setTransform(camera);
+ if (dense) {
+ framePainter.paintDense(p, viewport, level, rect());
+ return;
  }
 
- p.restore();
-}
\ No newline at end of file
+ //4. Draw nodes, batched by shape and fill
+ framePainter.paintNodes(p, exposed, full);
+
+ //5. Highlights: outer glow/outline for highlighted nodes
+ framePainter.paintHighlights(p, exposed);
+}
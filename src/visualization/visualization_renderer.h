@@ -1,11 +1,20 @@
 #pragma once
 
 #include <QWidget>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPixmap>
+#include <QTransform>
 #include <vector>
 #include <map>
 #include <string>
 #include <QPointF> // Récupéré du main (utile pour les coordonnées)
 #include "animation_frame.h" 
+#include "frame_interpolator.h"
+#include "render_list.h"
+#include "frame_painter.h"
+#include "tiled_rasterizer.h"
+#include <memory>
 
 class VisualizationRenderer : public QWidget {
     Q_OBJECT
@@ -14,7 +23,13 @@ public:
     explicit VisualizationRenderer(QWidget* parent = nullptr);
     ~VisualizationRenderer() override = default;
 
+    // Show a frame immediately (editing, reset)
     void renderFrame(const AnimationFrame& frame);
+    // Tween node positions and colors from what is on screen to 'frame'
+    void animateToFrame(const AnimationFrame& frame);
+    // Length of the tween started by animateToFrame; 0 disables it
+    void setTransitionDuration(int ms);
+    int getTransitionDuration() const { return transitionMs; }
     void renderVisualization(const QString& dot);
 
     // --- ZOOM ---
@@ -28,11 +43,59 @@ public:
     void panBy(double dx, double dy); // in logical coordinates (will be scaled appropriately)
     void setPanOffset(const QPointF& offset);
     QPointF getPanOffset() const { return panOffset; }
+    // Pan so that a scene point lands in the middle of the widget
+    void centerOn(const QPointF& scenePos);
+    // Scene rectangle currently visible in the widget
+    QRectF visibleSceneRect() const;
+    // Compiled form of the frame on screen, for overlays
+    const RenderList& scene() const { return renderList; }
+
+    // Render on a worker pool, one image per tile. Scenes with at least
+    // TILED_MIN_NODES nodes use it automatically; this forces it on.
+    void setTiledRendering(bool enabled);
+    bool isTiledRendering() const { return tiledForced; }
+
+signals:
+    // The compiled scene changed (new frame, tween step)
+    void sceneChanged();
+    // Zoom or pan changed
+    void viewChanged();
 
 protected:
     void paintEvent(QPaintEvent* event) override;
 
+private slots:
+    void onTransitionTick();
+
 private:
+    // A pre-rendered static layer and the state it was rendered for
+    struct LayerCache {
+        QPixmap pixmap;
+        QTransform camera;
+        QSize size;
+        double pixelRatio{ 0 };
+        unsigned long long version{ 0 };
+
+        bool isCurrent(const QTransform& t, const QSize& s, double ratio, unsigned long long v) const;
+        void reset(const QTransform& t, const QSize& s, double ratio, unsigned long long v);
+    };
+
+    // Background + grid, and edges (Full/Shapes tiers only)
+    void paintGridLayer(const QTransform& camera, const QRectF& viewport);
+    void paintEdgeLayer(const QTransform& camera, const QRectF& viewport, bool full);
+
+    // Layers, nodes and highlights for 'camera', limited to paintRect (widget pixels)
+    void paintScene(QPainter& p, const QTransform& camera, const QRect& paintRect);
+
+    // Rebuild renderList from currentFrame with the current widget font
+    void compileFrame();
+    // Scene -> widget transform for the current zoom and pan
+    QTransform cameraTransform() const;
+    // Schedule a repaint of just what renderList reports as changed
+    void invalidateChanged();
+    // Pan/zoom input: show the cached scene transformed until input goes idle
+    void beginViewGesture();
+
     float zoomLevel{ 1.0f };
     int baseNodeRadius = 20; // Ta variable de taille
 
@@ -42,4 +105,36 @@ private:
     // On garde cette variable du main pour le futur (Déplacement/Panning)
     // Même si on ne l'utilise pas tout de suite, c'est bien de l'avoir.
     AnimationFrame currentFrame;
+    // currentFrame compiled for painting; rebuilt when a frame arrives
+    RenderList renderList;
+    // Canvas drawing rules, shared with the offscreen renderer
+    FramePainter framePainter{ renderList, baseNodeRadius };
+    LayerCache gridLayer;
+    // Edge geometry version at the last invalidation; a change means full repaint
+    unsigned long long invalidatedEdgeVersion{ ~0ULL };
+    LayerCache edgeLayer;
+
+    // Last full-quality picture of the whole widget and the camera it was
+    // rendered with. While a pan/zoom gesture is active it is drawn with a
+    // transform instead of re-rendering the scene; the full render resumes
+    // once the gesture has been idle for GESTURE_IDLE_MS.
+    static constexpr int GESTURE_IDLE_MS = 150;
+    QPixmap sceneCache;
+    QTransform sceneCacheCamera;
+    bool sceneCacheValid{ false };
+    bool sceneDirty{ false };     // content changed since sceneCache was rendered
+    bool viewGesture{ false };
+    QTimer* gestureTimer{ nullptr };
+
+    // Multithreaded raster path, created the first time a scene needs it
+    static constexpr size_t TILED_MIN_NODES = 20000;
+    bool tiledForced{ false };
+    std::unique_ptr<TiledRasterizer> tiledRasterizer;
+
+    // Transition state: ~60 Hz tick that only updates the nodes that differ
+    static constexpr int TRANSITION_TICK_MS = 16;
+    FrameInterpolator interpolator;
+    QTimer* transitionTimer{ nullptr };
+    QElapsedTimer transitionClock;
+    int transitionMs{ 250 };
 };
\ No newline at end of file